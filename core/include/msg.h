@@ -232,6 +232,27 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
 
+/**
+ * @brief Send several messages in one go (non-blocking).
+ *
+ * Delivers the messages in @p m in order, as if @ref msg_try_send() was
+ * called for each of them, but with interrupts disabled only once and at
+ * most one reschedule. If the target is waiting for a message, the first
+ * message is handed over directly and the rest is put into the target's
+ * message queue. Delivery stops at the first message that does not fit into
+ * the queue. May be called from an ISR.
+ *
+ * @param[in] m             Array of @p n preallocated ``msg_t`` structures,
+ *                          must not be NULL. The ``sender_pid`` field of each
+ *                          delivered message is filled in.
+ * @param[in] n             Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  number of messages delivered (the first ones of @p m)
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned n, kernel_pid_t target_pid);
+
 /**
  * @brief Send a message to the current thread.
  * @details Will work only if the thread has a message queue.
@@ -309,6 +330,22 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive up to @p n messages.
+ *
+ * Takes as many messages as available (up to @p n) from the message queue
+ * and from send-blocked threads with interrupts disabled only once, in the
+ * order they would be returned by subsequent calls to @ref msg_receive().
+ * Blocks until a message was received if there is none.
+ *
+ * @param[out] m    Array of @p n preallocated ``msg_t`` structures, must not
+ *                  be NULL.
+ * @param[in] n     Size of @p m, must be greater than 0.
+ *
+ * @return  number of messages written to @p m (at least 1)
+ */
+int msg_receive_bulk(msg_t *m, unsigned n);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -377,6 +414,44 @@ void msg_init_queue(msg_t *array, int num);
  */
 void msg_queue_print(void);
 
+#if defined(MODULE_CORE_MSG_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Message statistics of a thread
+ *
+ * Requires the `core_msg_stats` module. All counters refer to messages sent
+ * *to* the thread, so an undersized message queue shows up as drops or
+ * blocked senders of the receiving thread.
+ */
+typedef struct {
+    uint32_t queued;        /**< messages put into the message queue */
+    uint32_t direct;        /**< messages handed directly to the waiting thread */
+    uint32_t dropped;       /**< messages dropped because the queue was full */
+    uint32_t send_blocked;  /**< senders blocked because the queue was full */
+    uint16_t queue_hwm;     /**< maximum number of queued messages */
+} msg_stats_t;
+
+/**
+ * @brief   Gets the message statistics of a thread
+ *
+ * @param[in] pid       the thread
+ * @param[out] stats    the statistics, must not be NULL
+ *
+ * @return  0 on success
+ * @return  -1, if @p pid is not a valid thread
+ */
+int msg_stats_get(kernel_pid_t pid, msg_stats_t *stats);
+
+/**
+ * @brief   Resets the message statistics of a thread
+ *
+ * @param[in] pid   the thread
+ *
+ * @return  0 on success
+ * @return  -1, if @p pid is not a valid thread
+ */
+int msg_stats_reset(kernel_pid_t pid);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
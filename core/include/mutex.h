@@ -11,6 +11,16 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * Threads waiting for a mutex are woken up in the order of their priority.
+ * With the `core_mutex_pi` module, mutexes additionally implement priority
+ * inheritance: while a thread waits for a mutex, the thread holding it (and
+ * transitively, the holder of a mutex that one waits for) runs with the
+ * waiter's priority if that is higher. This bounds the time a high priority
+ * thread waits for a mutex held by a low priority thread to the time the
+ * mutex is held, instead of additionally the runtime of all medium priority
+ * threads. When the holder unlocks a mutex, it keeps the highest priority of
+ * the threads still waiting for any of the other mutexes it holds.
  * @{
  *
  * @file
@@ -26,6 +36,7 @@
 
 #include "list.h"
 #include "atomic.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -41,13 +52,24 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex, only with `core_mutex_pi`
+     * @internal
+     */
+    kernel_pid_t owner;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PI
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Initializes a mutex object.
@@ -58,6 +80,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PI
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
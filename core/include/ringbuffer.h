@@ -34,6 +34,14 @@ typedef struct {
     unsigned int avail; /**< Number of elements available for reading. */
 } ringbuffer_t;
 
+/**
+ * @brief     Contiguous region of a ringbuffer's buffer.
+ */
+typedef struct {
+    char *buf;          /**< Start of the region. */
+    unsigned int len;   /**< Number of elements in the region. */
+} ringbuffer_span_t;
+
 /**
  * @def          RINGBUFFER_INIT(BUF)
  * @brief        Initialize a ringbuffer.
@@ -150,6 +158,37 @@ int ringbuffer_peek_one(const ringbuffer_t *__restrict rb);
  */
 unsigned ringbuffer_peek(const ringbuffer_t *__restrict rb, char *buf, unsigned n);
 
+/**
+ * @brief           Get the elements available for reading without copying them.
+ * @details         As the elements may wrap around the end of the buffer, they
+ *                  are returned as up to two regions, `span[0]` holding the
+ *                  older elements. Unused regions have a length of 0.
+ *                  Use ringbuffer_remove() when done with the elements.
+ * @param[in]       rb     Ringbuffer to operate on.
+ * @param[out]      span   The two regions.
+ * @returns         Number of elements available for reading.
+ */
+unsigned ringbuffer_peek_span(const ringbuffer_t *__restrict rb, ringbuffer_span_t span[2]);
+
+/**
+ * @brief           Get the free space of the ringbuffer to write into directly.
+ * @details         The free space is returned as up to two regions, `span[0]`
+ *                  has to be filled first. Unused regions have a length of 0.
+ *                  Use ringbuffer_commit() to add the written elements.
+ * @param[in]       rb     Ringbuffer to operate on.
+ * @param[out]      span   The two regions.
+ * @returns         Number of elements that can be written.
+ */
+unsigned ringbuffer_write_span(const ringbuffer_t *__restrict rb, ringbuffer_span_t span[2]);
+
+/**
+ * @brief           Add the elements written into the regions returned by
+ *                  ringbuffer_write_span() to the ringbuffer.
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, must not exceed ringbuffer_get_free().
+ */
+void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n);
+
 #ifdef __cplusplus
 }
 #endif
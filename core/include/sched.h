@@ -133,6 +133,20 @@ void sched_set_status(thread_t *process, unsigned int status);
  */
 void sched_switch(uint16_t other_prio);
 
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+/**
+ * @brief   Changes the priority of a thread, moving it to the matching run
+ *          queue if it is runnable
+ *
+ * Does not yield, use sched_switch() afterwards if needed. Must be called
+ * with interrupts disabled.
+ *
+ * @param[in]   thread      the thread
+ * @param[in]   priority    the new priority
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+#endif
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -29,6 +29,7 @@
 #include "cpu_conf.h"
 #include "sched.h"
 #include "clist.h"
+#include "mutex.h"
 
 #ifdef MODULE_CORE_THREAD_FLAGS
 #include "thread_flags.h"
@@ -78,6 +79,11 @@ struct _thread {
 
     kernel_pid_t pid;               /**< thread's process id            */
 
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without inheritance   */
+    mutex_t *mutex_wait;            /**< mutex the thread waits for     */
+#endif
+
 #ifdef MODULE_CORE_THREAD_FLAGS
     thread_flags_t flags;           /**< currently set flags            */
 #endif
@@ -92,6 +98,9 @@ struct _thread {
     cib_t msg_queue;                /**< message queue                  */
     msg_t *msg_array;               /**< memory holding messages        */
 #endif
+#if defined(MODULE_CORE_MSG_STATS) || defined(DOXYGEN)
+    msg_stats_t msg_stats;          /**< message statistics             */
+#endif
 
 #if defined DEVELHELP || defined(SCHED_TEST_STACK)
     char *stack_start;              /**< thread's stack start address   */
@@ -23,6 +23,7 @@
 #include <stddef.h>
 #include <inttypes.h>
 #include <assert.h>
+#include <string.h>
 #include "sched.h"
 #include "msg.h"
 #include "list.h"
@@ -30,15 +31,57 @@
 #include "irq.h"
 #include "cib.h"
 
+#ifdef MODULE_TRACE
+#include "trace.h"
+#endif
+#ifdef MODULE_CORE_THREAD_FLAGS
+#include "thread_flags.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 #include "thread.h"
 
 #ifdef MODULE_CORE_MSG
 
+#ifdef MODULE_CORE_MSG_STATS
+#define MSG_STATS_ADD(thread, counter, n)   ((thread)->msg_stats.counter += (n))
+#else
+#define MSG_STATS_ADD(thread, counter, n)
+#endif
+#define MSG_STATS_INC(thread, counter)      MSG_STATS_ADD(thread, counter, 1)
+
 static int _msg_receive(msg_t *m, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
+/**
+ * @brief   Accounts for a message put into the queue of @p target
+ */
+static inline void _msg_stats_queued(thread_t *target)
+{
+#ifdef MODULE_CORE_MSG_STATS
+    unsigned avail = cib_avail(&(target->msg_queue));
+
+    target->msg_stats.queued++;
+    if (avail > target->msg_stats.queue_hwm) {
+        target->msg_stats.queue_hwm = avail;
+    }
+#else
+    (void)target;
+#endif
+}
+
+/**
+ * @brief   Puts @p m into the message queue of @p target
+ *
+ * With thread flags, also sets THREAD_FLAG_MSG_WAITING for @p target. Must be
+ * called with interrupts disabled.
+ *
+ * @return  0 if the queue is full
+ * @return  1 if the message was queued
+ * @return  2 if the message was queued and @p target was woken up from
+ *          waiting for THREAD_FLAG_MSG_WAITING
+ */
 static int queue_msg(thread_t *target, const msg_t *m)
 {
     int n = cib_put(&(target->msg_queue));
@@ -50,6 +93,13 @@ static int queue_msg(thread_t *target, const msg_t *m)
     DEBUG("queue_msg(): queuing message\n");
     msg_t *dest = &target->msg_array[n];
     *dest = *m;
+    _msg_stats_queued(target);
+#ifdef MODULE_CORE_THREAD_FLAGS
+    target->flags |= THREAD_FLAG_MSG_WAITING;
+    if (thread_flags_wake(target)) {
+        return 2;
+    }
+#endif
     return 1;
 }
 
@@ -95,6 +145,10 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
 
     thread_t *me = (thread_t *) sched_active_thread;
 
+#ifdef MODULE_TRACE
+    trace_event(TRACE_MSG_SEND, target_pid);
+#endif
+
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
           ". block=%i src->state=%i target->state=%i\n", RIOT_FILE_RELATIVE,
           __LINE__, sched_active_pid, target_pid,
@@ -104,7 +158,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         DEBUG("msg_send() %s:%i: Target %" PRIkernel_pid " is not RECEIVE_BLOCKED.\n",
               RIOT_FILE_RELATIVE, __LINE__, target_pid);
 
-        if (queue_msg(target, m)) {
+        int res = queue_msg(target, m);
+        if (res) {
             DEBUG("msg_send() %s:%i: Target %" PRIkernel_pid
                   " has a msg_queue. Queueing message.\n", RIOT_FILE_RELATIVE,
                   __LINE__, target_pid);
@@ -112,18 +167,23 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
             if (me->status == STATUS_REPLY_BLOCKED) {
                 thread_yield_higher();
             }
+            else if (res > 1) {
+                sched_switch(target->priority);
+            }
             return 1;
         }
 
         if (!block) {
             DEBUG("msg_send: %" PRIkernel_pid ": Receiver not waiting, block=%u\n",
                   me->pid, block);
+            MSG_STATS_INC(target, dropped);
             irq_restore(state);
             return 0;
         }
 
         DEBUG("msg_send: %" PRIkernel_pid ": going send blocked.\n",
               me->pid);
+        MSG_STATS_INC(target, send_blocked);
 
         me->wait_data = (void*) m;
 
@@ -154,6 +214,7 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         msg_t *target_message = (msg_t*) target->wait_data;
         *target_message = *m;
         sched_set_status(target, STATUS_PENDING);
+        MSG_STATS_INC(target, direct);
 
         irq_restore(state);
         thread_yield_higher();
@@ -162,12 +223,81 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
     return 1;
 }
 
+int msg_send_bulk(msg_t *m, unsigned n, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned count = 0;
+    int woken = 0;
+
+#ifdef MODULE_TRACE
+    trace_event(TRACE_MSG_SEND, target_pid);
+#endif
+
+    if ((n > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_bulk: Direct msg copy from %" PRIkernel_pid " to %"
+              PRIkernel_pid ".\n", sender_pid, target_pid);
+        m[0].sender_pid = sender_pid;
+        /* copy first msg to target, the rest goes to the queue */
+        msg_t *target_message = (msg_t*) target->wait_data;
+        *target_message = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        MSG_STATS_INC(target, direct);
+        woken = 1;
+        count++;
+    }
+
+    for (; count < n; count++) {
+        m[count].sender_pid = sender_pid;
+        int res = queue_msg(target, &m[count]);
+        if (!res) {
+            break;
+        }
+        if (res > 1) {
+            woken = 1;
+        }
+    }
+    MSG_STATS_ADD(target, dropped, n - count);
+
+    DEBUG("msg_send_bulk: %u of %u messages delivered to %" PRIkernel_pid
+          ".\n", count, n, target_pid);
+
+    irq_restore(state);
+    if (woken) {
+        if (irq_is_in()) {
+            sched_context_switch_request = 1;
+        }
+        else {
+            thread_yield_higher();
+        }
+    }
+
+    return (int)count;
+}
+
 int msg_send_to_self(msg_t *m)
 {
     unsigned state = irq_disable();
 
     m->sender_pid = sched_active_pid;
     int res = queue_msg((thread_t *) sched_active_thread, m);
+    if (!res) {
+        MSG_STATS_INC((thread_t *) sched_active_thread, dropped);
+    }
 
     irq_restore(state);
     return res;
@@ -189,6 +319,9 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 
     m->sender_pid = KERNEL_PID_ISR;
+#ifdef MODULE_TRACE
+    trace_event(TRACE_MSG_SEND, target_pid);
+#endif
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", thread_getpid(), target_pid);
@@ -198,13 +331,22 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
         msg_t *target_message = (msg_t*) target->wait_data;
         *target_message = *m;
         sched_set_status(target, STATUS_PENDING);
+        MSG_STATS_INC(target, direct);
 
         sched_context_switch_request = 1;
         return 1;
     }
     else {
         DEBUG("msg_send_int: Receiver not waiting.\n");
-        return (queue_msg(target, m));
+        int res = queue_msg(target, m);
+        if (!res) {
+            MSG_STATS_INC(target, dropped);
+        }
+        else if (res > 1) {
+            sched_context_switch_request = 1;
+            res = 1;
+        }
+        return res;
     }
 }
 
@@ -266,12 +408,26 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
+#ifdef MODULE_TRACE
+    int res = _msg_receive(m, 0);
+    if (res == 1) {
+        trace_event(TRACE_MSG_RECEIVE, m->sender_pid);
+    }
+    return res;
+#else
     return _msg_receive(m, 0);
+#endif
 }
 
 int msg_receive(msg_t *m)
 {
+#ifdef MODULE_TRACE
+    int res = _msg_receive(m, 1);
+    trace_event(TRACE_MSG_RECEIVE, m->sender_pid);
+    return res;
+#else
     return _msg_receive(m, 1);
+#endif
 }
 
 static int _msg_receive(msg_t *m, int block)
@@ -336,6 +492,7 @@ static int _msg_receive(msg_t *m, int block)
              * waiter, take it's message into the just freed queue space.
              */
             m = &(me->msg_array[cib_put(&(me->msg_queue))]);
+            _msg_stats_queued(me);
         }
 
         /* copy msg */
@@ -360,6 +517,86 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+/**
+ * @brief   Takes the message of a send-blocked @p sender and wakes it up
+ *          (unless it is waiting for a reply).
+ *
+ * @return  priority of @p sender if it became runnable,
+ *          THREAD_PRIORITY_IDLE otherwise
+ */
+static uint16_t _msg_take_from_waiter(thread_t *sender, msg_t *m)
+{
+    msg_t *sender_msg = (msg_t*) sender->wait_data;
+    *m = *sender_msg;
+
+    if (sender->status != STATUS_REPLY_BLOCKED) {
+        sender->wait_data = NULL;
+        sched_set_status(sender, STATUS_PENDING);
+        return sender->priority;
+    }
+    return THREAD_PRIORITY_IDLE;
+}
+
+int msg_receive_bulk(msg_t *m, unsigned n)
+{
+    assert(n > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t*) sched_threads[sched_active_pid];
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned count = 0;
+    list_node_t *next;
+
+    if (me->msg_array) {
+        int queue_index;
+        while ((count < n) &&
+               ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+            m[count++] = me->msg_array[queue_index];
+        }
+    }
+
+    /* the queue is drained (or full), so waiting senders come next in order */
+    while ((count < n) && ((next = list_remove_head(&me->msg_waiters)) != NULL)) {
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        uint16_t prio = _msg_take_from_waiter(sender, &m[count++]);
+        if (prio < sender_prio) {
+            sender_prio = prio;
+        }
+    }
+
+    /* refill the just freed queue space from remaining waiters */
+    while (me->msg_array && me->msg_waiters.next &&
+           (cib_avail(&(me->msg_queue)) <= me->msg_queue.mask)) {
+        next = list_remove_head(&me->msg_waiters);
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        uint16_t prio = _msg_take_from_waiter(sender,
+                            &(me->msg_array[cib_put(&(me->msg_queue))]));
+        _msg_stats_queued(me);
+        if (prio < sender_prio) {
+            sender_prio = prio;
+        }
+    }
+
+    if (count == 0) {
+        DEBUG("msg_receive_bulk(): %" PRIkernel_pid ": No msg in queue. "
+              "Going blocked.\n", sched_active_thread->pid);
+        me->wait_data = (void *) m;
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+
+        irq_restore(state);
+        thread_yield_higher();
+
+        /* sender copied message */
+        return 1;
+    }
+
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return (int)count;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
@@ -407,4 +644,42 @@ void msg_queue_print(void)
     irq_restore(state);
 }
 
+#ifdef MODULE_CORE_MSG_STATS
+int msg_stats_get(kernel_pid_t pid, msg_stats_t *stats)
+{
+    if (!pid_is_valid(pid)) {
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+
+    if (thread == NULL) {
+        irq_restore(state);
+        return -1;
+    }
+    *stats = thread->msg_stats;
+    irq_restore(state);
+    return 0;
+}
+
+int msg_stats_reset(kernel_pid_t pid)
+{
+    if (!pid_is_valid(pid)) {
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+
+    if (thread == NULL) {
+        irq_restore(state);
+        return -1;
+    }
+    memset(&thread->msg_stats, 0, sizeof(thread->msg_stats));
+    irq_restore(state);
+    return 0;
+}
+#endif
+
 #endif /* MODULE_CORE_MSG */
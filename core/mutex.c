@@ -32,11 +32,124 @@
 #include "thread.h"
 #include "list.h"
 
+#ifdef MODULE_TRACE
+#include "trace.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 #define MUTEX_LOCKED ((void*)-1)
 
+#ifdef MODULE_CORE_MUTEX_PI
+/**
+ * @brief   Boosts the holder of @p mutex (and the holders of the mutexes it
+ *          waits for) to @p priority
+ */
+static void _mutex_boost(mutex_t *mutex, uint8_t priority)
+{
+    while (mutex && (mutex->owner != KERNEL_PID_UNDEF)) {
+        thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+
+        if ((owner == NULL) || (owner->priority <= priority)) {
+            return;
+        }
+        DEBUG("PID[%" PRIkernel_pid "]: boosting holder %" PRIkernel_pid
+              " to priority %u\n", sched_active_pid, owner->pid,
+              (unsigned)priority);
+        sched_change_priority(owner, priority);
+
+        if (owner->status != STATUS_MUTEX_BLOCKED) {
+            return;
+        }
+        /* re-sort the holder into the queue of the mutex it waits for */
+        mutex = owner->mutex_wait;
+        list_node_t *node = &mutex->queue;
+        while (node->next != &owner->rq_entry) {
+            node = node->next;
+        }
+        node->next = owner->rq_entry.next;
+        thread_add_to_list(&mutex->queue, owner);
+    }
+}
+
+/**
+ * @brief   Drops the boost of thread @p pid after it released a mutex
+ *
+ * The thread keeps the highest priority of the threads still waiting for
+ * any of the mutexes it holds.
+ *
+ * @return  1 if the priority of the thread was lowered
+ */
+static int _mutex_unboost(kernel_pid_t pid)
+{
+    thread_t *owner = (thread_t *)sched_threads[pid];
+
+    if ((owner == NULL) || (owner->priority == owner->base_priority)) {
+        return 0;
+    }
+
+    uint8_t priority = owner->base_priority;
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        thread_t *waiter = (thread_t *)sched_threads[i];
+
+        if (waiter && (waiter->status == STATUS_MUTEX_BLOCKED) &&
+            waiter->mutex_wait && (waiter->mutex_wait->owner == pid) &&
+            (waiter->priority < priority)) {
+            priority = waiter->priority;
+        }
+    }
+
+    if (priority <= owner->priority) {
+        return 0;
+    }
+    DEBUG("PID[%" PRIkernel_pid "]: unboosting %" PRIkernel_pid
+          " to priority %u\n", sched_active_pid, pid, (unsigned)priority);
+    sched_change_priority(owner, priority);
+    return 1;
+}
+
+/**
+ * @brief   Lets threads preempt the (former) holder after its boost dropped
+ */
+static void _mutex_yield(void)
+{
+    if (irq_is_in()) {
+        sched_context_switch_request = 1;
+    }
+    else {
+        thread_yield_higher();
+    }
+}
+
+/**
+ * @brief   Hands @p mutex over to the highest priority waiter
+ */
+static thread_t *_mutex_handover(mutex_t *mutex)
+{
+    list_node_t *next = list_remove_head(&mutex->queue);
+    thread_t *process = container_of((clist_node_t*)next, thread_t, rq_entry);
+
+    mutex->owner = process->pid;
+    process->mutex_wait = NULL;
+    /* the remaining waiters now boost the new holder */
+    if (mutex->queue.next) {
+        thread_t *waiter = container_of((clist_node_t*)mutex->queue.next,
+                                        thread_t, rq_entry);
+        if (waiter->priority < process->priority) {
+            sched_change_priority(process, waiter->priority);
+        }
+    }
+    return process;
+}
+#else
+static inline thread_t *_mutex_handover(mutex_t *mutex)
+{
+    list_node_t *next = list_remove_head(&mutex->queue);
+    return container_of((clist_node_t*)next, thread_t, rq_entry);
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -46,6 +159,9 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PI
+        mutex->owner = sched_active_pid;
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -63,6 +179,13 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+#ifdef MODULE_CORE_MUTEX_PI
+        me->mutex_wait = mutex;
+        _mutex_boost(mutex, me->priority);
+#endif
+#ifdef MODULE_TRACE
+        trace_event(TRACE_MUTEX_BLOCK, (uintptr_t)mutex);
+#endif
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -88,25 +211,46 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+#ifdef MODULE_CORE_MUTEX_PI
+    kernel_pid_t owner = mutex->owner;
+#endif
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PI
+        mutex->owner = KERNEL_PID_UNDEF;
+        if (_mutex_unboost(owner)) {
+            irq_restore(irqstate);
+            _mutex_yield();
+            return;
+        }
+#endif
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
         return;
     }
 
-    list_node_t *next = list_remove_head(&mutex->queue);
-
-    thread_t *process = container_of((clist_node_t*)next, thread_t, rq_entry);
+    thread_t *process = _mutex_handover(mutex);
 
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+#ifdef MODULE_TRACE
+    trace_event(TRACE_MUTEX_UNBLOCK, (uintptr_t)mutex);
+#endif
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
 
+#ifdef MODULE_CORE_MUTEX_PI
+    if (_mutex_unboost(owner)) {
+        irq_restore(irqstate);
+        _mutex_yield();
+        return;
+    }
+#endif
+
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
     sched_switch(process_priority);
@@ -119,19 +263,29 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+#ifdef MODULE_CORE_MUTEX_PI
+        kernel_pid_t owner = mutex->owner;
+#endif
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PI
+            mutex->owner = KERNEL_PID_UNDEF;
+#endif
         }
         else {
-            list_node_t *next = list_remove_head(&mutex->queue);
-            thread_t *process = container_of((clist_node_t*)next, thread_t,
-                                             rq_entry);
+            thread_t *process = _mutex_handover(mutex);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+#ifdef MODULE_TRACE
+            trace_event(TRACE_MUTEX_UNBLOCK, (uintptr_t)mutex);
+#endif
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
         }
+#ifdef MODULE_CORE_MUTEX_PI
+        _mutex_unboost(owner);
+#endif
     }
 
     DEBUG("PID[%" PRIkernel_pid "]: going to sleep.\n", sched_active_pid);
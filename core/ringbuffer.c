@@ -18,6 +18,7 @@
 
 #include "ringbuffer.h"
 
+#include <assert.h>
 #include <string.h>
 
 /**
@@ -52,16 +53,45 @@ static char get_head(ringbuffer_t *restrict rb)
     return result;
 }
 
+/**
+ * @brief           Split n elements starting at pos into up to two regions.
+ * @param[in]       rb     Ringbuffer to operate on.
+ * @param[in]       pos    Position of the first element, must be smaller than rb->size.
+ * @param[in]       n      Number of elements, must not exceed rb->size.
+ * @param[out]      span   The two regions.
+ */
+static void split_span(const ringbuffer_t *restrict rb, unsigned pos, unsigned n,
+                       ringbuffer_span_t span[2])
+{
+    unsigned bytes_till_end = rb->size - pos;
+    span[0].buf = rb->buf + pos;
+    span[1].buf = rb->buf;
+    if (n <= bytes_till_end) {
+        span[0].len = n;
+        span[1].len = 0;
+    }
+    else {
+        span[0].len = bytes_till_end;
+        span[1].len = n - bytes_till_end;
+    }
+}
+
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
-        }
-        add_tail(rb, buf[i]);
+    ringbuffer_span_t span[2];
+    unsigned free = ringbuffer_write_span(rb, span);
+    if (n > free) {
+        n = free;
+    }
+    if (n <= span[0].len) {
+        memcpy(span[0].buf, buf, n);
     }
-    return i;
+    else {
+        memcpy(span[0].buf, buf, span[0].len);
+        memcpy(span[1].buf, buf + span[0].len, n - span[0].len);
+    }
+    rb->avail += n;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -117,12 +147,12 @@ unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
         rb->start = rb->avail = 0;
     }
     else {
-        rb->start -= n;
+        rb->start += n;
         rb->avail -= n;
 
-        /* compensate underflow */
-        if (rb->start > rb->size) {
-            rb->start += rb->size;
+        /* compensate overflow */
+        if (rb->start >= rb->size) {
+            rb->start -= rb->size;
         }
     }
 
@@ -140,3 +170,25 @@ unsigned ringbuffer_peek(const ringbuffer_t *restrict rb_, char *buf, unsigned n
     ringbuffer_t rb = *rb_;
     return ringbuffer_get(&rb, buf, n);
 }
+
+unsigned ringbuffer_peek_span(const ringbuffer_t *restrict rb, ringbuffer_span_t span[2])
+{
+    split_span(rb, rb->start, rb->avail, span);
+    return rb->avail;
+}
+
+unsigned ringbuffer_write_span(const ringbuffer_t *restrict rb, ringbuffer_span_t span[2])
+{
+    unsigned pos = rb->start + rb->avail;
+    if (pos >= rb->size) {
+        pos -= rb->size;
+    }
+    split_span(rb, pos, rb->size - rb->avail, span);
+    return rb->size - rb->avail;
+}
+
+void ringbuffer_commit(ringbuffer_t *restrict rb, unsigned n)
+{
+    assert(n <= ringbuffer_get_free(rb));
+    rb->avail += n;
+}
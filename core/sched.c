@@ -33,6 +33,10 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_TRACE
+#include "trace.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -115,6 +119,10 @@ int sched_run(void)
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
 
+#ifdef MODULE_TRACE
+    trace_event(TRACE_SCHED, active_thread ? active_thread->pid : KERNEL_PID_UNDEF);
+#endif
+
     DEBUG("sched_run: done, changed sched_active_thread.\n");
 
     return 1;
@@ -152,6 +160,42 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
+#ifdef MODULE_CORE_MUTEX_PI
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    if (thread->priority == priority) {
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " from %" PRIu16
+          " to %" PRIu16 "\n", thread->pid, (uint16_t)thread->priority,
+          (uint16_t)priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_node_t *rq = &sched_runqueues[thread->priority];
+        clist_node_t *last = rq->next;
+
+        /* rotate the thread to the head of its run queue and remove it,
+         * the order of the remaining threads stays the same */
+        while (rq->next->next != &thread->rq_entry) {
+            clist_advance(rq);
+        }
+        clist_remove_head(rq);
+        if (!rq->next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        else if (last != &thread->rq_entry) {
+            rq->next = last;
+        }
+
+        clist_insert(&sched_runqueues[priority], &thread->rq_entry);
+        runqueue_bitcache |= 1 << priority;
+    }
+
+    thread->priority = priority;
+}
+#endif
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
@@ -20,6 +20,7 @@
 
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "assert.h"
 #include "thread.h"
@@ -222,6 +223,10 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
 
     cb->priority = priority;
     cb->status = 0;
+#ifdef MODULE_CORE_MUTEX_PI
+    cb->base_priority = priority;
+    cb->mutex_wait = NULL;
+#endif
 
     cb->rq_entry.next = NULL;
 
@@ -231,6 +236,9 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cib_init(&(cb->msg_queue), 0);
     cb->msg_array = NULL;
 #endif
+#ifdef MODULE_CORE_MSG_STATS
+    memset(&cb->msg_stats, 0, sizeof(cb->msg_stats));
+#endif
 
     sched_num_threads++;
 
@@ -22,19 +22,44 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef MODULE_NATIVE_ASYNC_READ_EPOLL
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
 
+#if defined(MODULE_NATIVE_ASYNC_READ_EPOLL) && !defined(__linux__)
+#error "native_async_read_epoll is only available on Linux"
+#endif
+
 static int _next_index;
 static int _fds[ASYNC_READ_NUMOF];
 static native_async_read_callback_t _native_async_read_callbacks[ASYNC_READ_NUMOF];
 
+#ifdef MODULE_NATIVE_ASYNC_READ_EPOLL
+static int _epfd = -1;
+#endif
+
 #ifdef __MACH__
 static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#ifdef MODULE_NATIVE_ASYNC_READ_EPOLL
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_NUMOF];
+
+    /* only the file descriptors that became readable are reported */
+    int num = epoll_wait(_epfd, events, ASYNC_READ_NUMOF, 0);
+
+    for (int i = 0; i < num; i++) {
+        int index = events[i].data.u32;
+
+        _native_async_read_callbacks[index](_fds[index]);
+    }
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -58,14 +83,27 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#ifdef MODULE_NATIVE_ASYNC_READ_EPOLL
+    if ((_epfd < 0) && ((_epfd = epoll_create1(EPOLL_CLOEXEC)) < 0)) {
+        err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
 void native_async_read_cleanup(void) {
     unregister_interrupt(SIGIO);
 
+#ifdef MODULE_NATIVE_ASYNC_READ_EPOLL
+    if (_epfd >= 0) {
+        real_close(_epfd);
+        _epfd = -1;
+    }
+#endif
+
 #ifdef __MACH__
     for (int i = 0; i < _next_index; i++) {
         kill(_sigio_child_pids[i], SIGKILL);
@@ -105,6 +143,16 @@ void native_async_read_add_handler(int fd, native_async_read_callback_t handler)
     if (fcntl(fd, F_SETFL, O_NONBLOCK | O_ASYNC) == -1) {
         err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETFL)");
     }
+#ifdef MODULE_NATIVE_ASYNC_READ_EPOLL
+    struct epoll_event event = {
+        .events = EPOLLIN | EPOLLET,
+        .data = { .u32 = _next_index },
+    };
+
+    if (epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl");
+    }
+#endif
 #endif /* not OSX */
 
     _next_index++;
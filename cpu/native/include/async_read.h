@@ -60,6 +60,13 @@ void native_async_read_continue(int fd);
 /**
  * @brief   start monitoring of file descriptor
  *
+ * With the `native_async_read_epoll` module (Linux only) the file descriptors
+ * are watched by an edge-triggered epoll instance, so a SIGIO only dispatches
+ * the file descriptors that became readable instead of `select()`ing all of
+ * them. As no further event is generated for data that is already pending,
+ * @p handler (or whoever it defers the reading to) must read from @p fd until
+ * the read would block.
+ *
  * @param[in] fd       The file descriptor to monitor
  * @param[in] handler  The callback function to be called when the file
  *                     descriptor is ready to read.
@@ -67,8 +67,38 @@ void native_cpu_init(void);
 void native_interrupt_init(void);
 
 void native_irq_handler(void);
+void _native_irq_dispatch(void);
 extern void _native_sig_leave_tramp(void);
 
+/**
+ * context switching functions
+ *
+ * With the `native_virq` module, contexts are switched by hand-written
+ * replacements of swapcontext()/setcontext() that do not touch the signal
+ * mask, as interrupts are masked by native_interrupts_enabled only.
+ */
+#ifdef MODULE_NATIVE_VIRQ
+int _native_swapcontext(ucontext_t *oucp, const ucontext_t *ucp);
+int _native_setcontext(const ucontext_t *ucp);
+#define native_swapcontext(oucp, ucp)   _native_swapcontext(oucp, ucp)
+#define native_setcontext(ucp)          _native_setcontext(ucp)
+
+/**
+ * @brief   Store the current MXCSR in a context created by getcontext()
+ *
+ * glibc's getcontext() saves the x87 control word but not MXCSR, which
+ * _native_setcontext() restores.
+ */
+static inline void native_context_init_fpu(ucontext_t *ucp)
+{
+    __asm__ volatile ("stmxcsr %0" : "=m" (ucp->__fpregs_mem.status));
+}
+#else
+#define native_swapcontext(oucp, ucp)   swapcontext(oucp, ucp)
+#define native_setcontext(ucp)          setcontext(ucp)
+#define native_context_init_fpu(ucp)    (void)(ucp)
+#endif
+
 void _native_syscall_leave(void);
 void _native_syscall_enter(void);
 void _native_init_syscalls(void);
@@ -27,6 +27,7 @@ extern "C" {
 #include <stdint.h>
 #include "net/netdev2.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +36,16 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames handed up per interrupt
+ *
+ * All frames pending on the tap device are read in one go, up to this number.
+ * Remaining frames are handled after the next event.
+ */
+#ifndef NETDEV2_TAP_RX_BATCH
+#define NETDEV2_TAP_RX_BATCH    (16U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +55,10 @@ typedef struct netdev2_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    int rx_len;                         /**< Length of the frame in rx_buf,
+                                             0 if there is none */
+    uint8_t rx_buf[ETHERNET_FRAME_LEN]; /**< Frame read ahead of
+                                             netdev2_driver_t::recv() */
 } netdev2_tap_t;
 
 /**
@@ -47,6 +47,11 @@
  */
 #define TIMER_NUMOF        (1U)
 #define TIMER_0_EN         1
+#ifdef MODULE_NATIVE_TIMER_ABSTIME
+#define NATIVE_TIMER_CHANNELS   (4U)
+#else
+#define NATIVE_TIMER_CHANNELS   (1U)
+#endif
 
 /**
  * @brief xtimer configuration
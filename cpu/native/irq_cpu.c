@@ -42,9 +42,17 @@
 
 #include "native_internal.h"
 
+#ifdef MODULE_TRACE
+#include "trace.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if defined(MODULE_NATIVE_VIRQ) && !(defined(__linux__) && defined(__i386__))
+#error "native_virq is only available on Linux/x86"
+#endif
+
 volatile int native_interrupts_enabled;
 volatile int _native_in_isr;
 volatile int _native_in_syscall;
@@ -135,6 +143,48 @@ void native_print_signals(void)
     }
 }
 
+#ifdef MODULE_NATIVE_VIRQ
+/**
+ * mask interrupts
+ *
+ * Signals are not blocked, native_isr_entry() only queues them while
+ * native_interrupts_enabled is 0.
+ */
+unsigned irq_disable(void)
+{
+    unsigned int prev_state = native_interrupts_enabled;
+
+    native_interrupts_enabled = 0;
+
+    return prev_state;
+}
+
+/**
+ * unmask interrupts, handle the signals queued in the meantime
+ */
+unsigned irq_enable(void)
+{
+    unsigned int prev_state = native_interrupts_enabled;
+
+    if (_native_in_isr == 1) {
+#ifdef DEVELHELP
+        real_write(STDERR_FILENO, "irq_enable + _native_in_isr\n", 27);
+#else
+        DEBUG("irq_enable + _native_in_isr\n");
+#endif
+    }
+
+    native_interrupts_enabled = 1;
+
+    if (_native_sigpend > 0) {
+        /* switches to the ISR context if the signals can be handled now */
+        _native_in_syscall++;
+        _native_syscall_leave();
+    }
+
+    return prev_state;
+}
+#else
 /**
  * block signals
  */
@@ -197,6 +247,7 @@ unsigned irq_enable(void)
 
     return prev_state;
 }
+#endif /* MODULE_NATIVE_VIRQ */
 
 void irq_restore(unsigned state)
 {
@@ -239,20 +290,25 @@ int _native_popsig(void)
 }
 
 /**
- * call signal handlers,
- * restore user context
+ * call signal handlers of all queued signals
  */
-void native_irq_handler(void)
+void _native_irq_dispatch(void)
 {
-    DEBUG("\n\n\t\tnative_irq_handler\n\n");
-
     while (_native_sigpend > 0) {
         int sig = _native_popsig();
-        _native_sigpend--;
+        /* with native_virq, signals are not blocked in the ISR context, so
+         * native_isr_entry() may increment the counter meanwhile */
+        __sync_fetch_and_sub(&_native_sigpend, 1);
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+#ifdef MODULE_TRACE
+            trace_event(TRACE_ISR_ENTER, sig);
+#endif
             native_irq_handlers[sig]();
+#ifdef MODULE_TRACE
+            trace_event(TRACE_ISR_EXIT, sig);
+#endif
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
@@ -261,6 +317,17 @@ void native_irq_handler(void)
             errx(EXIT_FAILURE, "XXX: no handler for signal %i\nXXX: this should not have happened!\n", sig);
         }
     }
+}
+
+/**
+ * call signal handlers,
+ * restore user context
+ */
+void native_irq_handler(void)
+{
+    DEBUG("\n\n\t\tnative_irq_handler\n\n");
+
+    _native_irq_dispatch();
 
     DEBUG("native_irq_handler: return\n");
     cpu_switch_context_exit();
@@ -268,7 +335,13 @@ void native_irq_handler(void)
 
 void isr_set_sigmask(ucontext_t *ctx)
 {
+#ifdef MODULE_NATIVE_VIRQ
+    /* the ISR is entered via _native_sig_leave_tramp with the signals
+     * unblocked, new ones are queued as _native_in_isr is set */
+    (void)ctx;
+#else
     ctx->uc_sigmask = _native_sig_set_dint;
+#endif
 }
 
 /**
@@ -283,7 +356,7 @@ void native_isr_entry(int sig, siginfo_t *info, void *context)
     if (real_write(_sig_pipefd[1], &sig, sizeof(int)) == -1) {
         err(EXIT_FAILURE, "native_isr_entry: real_write()");
     }
-    _native_sigpend++;
+    __sync_fetch_and_add(&_native_sigpend, 1);
     //real_write(STDOUT_FILENO, "sigpend\n", 8);
 
     if (context == NULL) {
@@ -497,6 +570,7 @@ void native_interrupt_init(void)
     if (getcontext(&native_isr_context) == -1) {
         err(EXIT_FAILURE, "native_interrupt_init: getcontext");
     }
+    native_context_init_fpu(&native_isr_context);
 
     native_isr_context.uc_stack.ss_sp = __isr_stack;
     native_isr_context.uc_stack.ss_size = SIGSTKSZ;
@@ -520,6 +594,17 @@ void native_interrupt_init(void)
         err(EXIT_FAILURE, "native_interrupt_init: pipe");
     }
 
+#ifdef MODULE_NATIVE_VIRQ
+    /* signals stay unblocked from now on, see irq_disable() */
+    sigset_t sig_set_none;
+    if (sigemptyset(&sig_set_none) == -1) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigemptyset");
+    }
+    if (sigprocmask(SIG_SETMASK, &sig_set_none, NULL) == -1) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigprocmask");
+    }
+#endif
+
     /* allow for ctrl+c to shut down gracefully always */
     //register_interrupt(SIGINT, native_shutdown);
     sa.sa_sigaction = native_shutdown;
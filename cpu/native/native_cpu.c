@@ -65,6 +65,15 @@ extern netdev2_tap_t netdev2_tap;
 ucontext_t end_context;
 char __end_stack[SIGSTKSZ];
 
+#ifdef MODULE_NATIVE_VIRQ
+#include <stddef.h>
+/* tramp.S hard-codes the offsets of the i386 registers in ucontext_t */
+typedef char _uc_gregs_offset_check[((offsetof(ucontext_t, uc_mcontext.gregs) == 20) &&
+                                     (sizeof(greg_t) == 4)) ? 1 : -1];
+typedef char _uc_fpregs_offset_check[((offsetof(ucontext_t, __fpregs_mem.cw) == 236) &&
+                                      (offsetof(ucontext_t, __fpregs_mem.status) == 344)) ? 1 : -1];
+#endif
+
 /**
  * TODO: implement
  */
@@ -74,6 +83,25 @@ void thread_print_stack(void)
     return;
 }
 
+#ifdef MODULE_NATIVE_VIRQ
+/**
+ * entry point of new threads
+ *
+ * Contexts are switched to with interrupts disabled and _native_in_isr set,
+ * so the switched-to context has to leave the ISR state itself.
+ */
+static void _native_thread_start(thread_task_func_t task_func, void *arg)
+{
+    _native_in_isr = 0;
+    irq_enable();
+    task_func(arg);
+
+    /* do not return through uc_link, glibc's setcontext() would restore
+     * the signal mask */
+    _native_setcontext(&end_context);
+}
+#endif
+
 char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_start, int stacksize)
 {
     char *stk;
@@ -93,6 +121,7 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
     if (getcontext(p) == -1) {
         err(EXIT_FAILURE, "thread_stack_init: getcontext");
     }
+    native_context_init_fpu(p);
 
     p->uc_stack.ss_sp = stk;
     p->uc_stack.ss_size = stacksize;
@@ -103,7 +132,11 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
         err(EXIT_FAILURE, "thread_stack_init: sigemptyset");
     }
 
+#ifdef MODULE_NATIVE_VIRQ
+    makecontext(p, (void (*)(void)) _native_thread_start, 2, task_func, arg);
+#else
     makecontext(p, (void (*)(void)) task_func, 1, arg);
+#endif
 
     return (char *) p;
 }
@@ -113,6 +146,10 @@ void isr_cpu_switch_context_exit(void)
     ucontext_t *ctx;
 
     DEBUG("isr_cpu_switch_context_exit\n");
+#ifdef MODULE_NATIVE_VIRQ
+    /* signals arriving in the ISR are only queued */
+    _native_irq_dispatch();
+#endif
     if ((sched_context_switch_request == 1) || (sched_active_thread == NULL)) {
         sched_run();
     }
@@ -120,12 +157,14 @@ void isr_cpu_switch_context_exit(void)
     DEBUG("isr_cpu_switch_context_exit: calling setcontext(%" PRIkernel_pid ")\n\n", sched_active_pid);
     ctx = (ucontext_t *)(sched_active_thread->sp);
 
+#ifndef MODULE_NATIVE_VIRQ
     /* the next context will have interrupts enabled due to ucontext */
     DEBUG("isr_cpu_switch_context_exit: native_interrupts_enabled = 1;\n");
     native_interrupts_enabled = 1;
     _native_in_isr = 0;
+#endif
 
-    if (setcontext(ctx) == -1) {
+    if (native_setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_cpu_switch_context_exit: setcontext");
     }
     errx(EXIT_FAILURE, "2 this should have never been reached!!");
@@ -147,7 +186,7 @@ void cpu_switch_context_exit(void)
         native_isr_context.uc_stack.ss_size = SIGSTKSZ;
         native_isr_context.uc_stack.ss_flags = 0;
         makecontext(&native_isr_context, isr_cpu_switch_context_exit, 0);
-        if (setcontext(&native_isr_context) == -1) {
+        if (native_setcontext(&native_isr_context) == -1) {
             err(EXIT_FAILURE, "cpu_switch_context_exit: swapcontext");
         }
         errx(EXIT_FAILURE, "1 this should have never been reached!!");
@@ -162,13 +201,18 @@ void isr_thread_yield(void)
 {
     DEBUG("isr_thread_yield\n");
 
+#ifdef MODULE_NATIVE_VIRQ
+    _native_irq_dispatch();
+#endif
     sched_run();
     ucontext_t *ctx = (ucontext_t *)(sched_active_thread->sp);
     DEBUG("isr_thread_yield: switching to(%" PRIkernel_pid ")\n\n", sched_active_pid);
 
+#ifndef MODULE_NATIVE_VIRQ
     native_interrupts_enabled = 1;
     _native_in_isr = 0;
-    if (setcontext(ctx) == -1) {
+#endif
+    if (native_setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_thread_yield: setcontext");
     }
 }
@@ -183,9 +227,12 @@ void thread_yield_higher(void)
         native_isr_context.uc_stack.ss_size = SIGSTKSZ;
         native_isr_context.uc_stack.ss_flags = 0;
         makecontext(&native_isr_context, isr_thread_yield, 0);
-        if (swapcontext(ctx, &native_isr_context) == -1) {
+        if (native_swapcontext(ctx, &native_isr_context) == -1) {
             err(EXIT_FAILURE, "thread_yield_higher: swapcontext");
         }
+#ifdef MODULE_NATIVE_VIRQ
+        _native_in_isr = 0;
+#endif
         irq_enable();
     }
     else {
@@ -198,6 +245,7 @@ void native_cpu_init(void)
     if (getcontext(&end_context) == -1) {
         err(EXIT_FAILURE, "native_cpu_init: getcontext");
     }
+    native_context_init_fpu(&end_context);
 
     end_context.uc_stack.ss_sp = __end_stack;
     end_context.uc_stack.ss_size = SIGSTKSZ;
@@ -69,6 +69,7 @@ netdev2_tap_t netdev2_tap;
 static int _init(netdev2_t *netdev);
 static int _send(netdev2_t *netdev, const struct iovec *vector, int n);
 static int _recv(netdev2_t *netdev, char* buf, int n, void *info);
+static void _isr(netdev2_t *netdev);
 
 static inline void _get_mac_addr(netdev2_t *netdev, uint8_t *dst)
 {
@@ -95,18 +96,6 @@ static inline int _set_promiscous(netdev2_t *netdev, int value)
     return value;
 }
 
-static inline void _isr(netdev2_t *netdev)
-{
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE, NULL);
-    }
-#if DEVELHELP
-    else {
-        puts("netdev2_tap: _isr(): no event_callback set.");
-    }
-#endif
-}
-
 static int _get(netdev2_t *dev, netopt_t opt, void *value, size_t max_len)
 {
     if (dev != (netdev2_t *)&netdev2_tap) {
@@ -184,104 +173,111 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev2_tap_t *dev)
+static void _tap_isr(int fd);
+
+/* reads the next frame ahead into dev->rx_buf, so its length is known before
+ * the upper layer allocates memory for it */
+static int _read_frame(netdev2_tap_t *dev)
 {
-    /* work around lost signals */
-    fd_set rfds;
-    struct timeval t;
-    memset(&t, 0, sizeof(t));
-    FD_ZERO(&rfds);
-    FD_SET(dev->tap_fd, &rfds);
-
-    _native_in_syscall++; /* no switching here */
-
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
-        int sig = SIGIO;
-        extern int _sig_pipefd[2];
-        extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
-        real_write(_sig_pipefd[1], &sig, sizeof(int));
-        _native_sigpend++;
-        DEBUG("netdev2_tap: sigpend++\n");
+    int nread = real_read(dev->tap_fd, dev->rx_buf, sizeof(dev->rx_buf));
+    DEBUG("netdev2_tap: read %d bytes\n", nread);
+
+    if (nread > 0) {
+        return nread;
+    }
+    else if (nread == -1) {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+            err(EXIT_FAILURE, "netdev2_tap: read");
+        }
+    }
+    else if (nread == 0) {
+        DEBUG("_native_handle_tap_input: ignoring null-event");
     }
     else {
-        DEBUG("netdev2_tap: native_async_read_continue\n");
-        native_async_read_continue(dev->tap_fd);
+        errx(EXIT_FAILURE, "internal error _rx_event");
+    }
+
+    return 0;
+}
+
+static bool _is_for_me(netdev2_tap_t *dev)
+{
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)dev->rx_buf;
+
+    if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
+        !_is_addr_broadcast(hdr->dst) &&
+        (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        DEBUG("netdev2_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+              "That's not me => Dropped\n",
+              hdr->dst[0], hdr->dst[1], hdr->dst[2],
+              hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+        return false;
+    }
+    return true;
+}
+
+static void _isr(netdev2_t *netdev)
+{
+    netdev2_tap_t *dev = (netdev2_tap_t*)netdev;
+
+    if (!netdev->event_callback) {
+#if DEVELHELP
+        puts("netdev2_tap: _isr(): no event_callback set.");
+#endif
+        return;
     }
 
-    _native_in_syscall--;
+    /* hand up all frames pending on the tap device in one go, instead of
+     * checking for further frames with select() and a new event per frame.
+     * Reading until the read would block is also what the edge-triggered
+     * native_async_read_epoll backend requires, as it raises no new event
+     * for frames that are already queued */
+    for (unsigned i = 0; i < NETDEV2_TAP_RX_BATCH; i++) {
+        dev->rx_len = _read_frame(dev);
+        if (dev->rx_len == 0) {
+            DEBUG("netdev2_tap: native_async_read_continue\n");
+            native_async_read_continue(dev->tap_fd);
+            return;
+        }
+        if (_is_for_me(dev)) {
+            netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE, NULL);
+        }
+        dev->rx_len = 0;
+    }
+
+    /* there may be more frames, which won't raise a new event with
+     * native_async_read_epoll: continue after the pending messages */
+    _tap_isr(dev->tap_fd);
 }
 
 static int _recv(netdev2_t *netdev2, char *buf, int len, void *info)
 {
     netdev2_tap_t *dev = (netdev2_tap_t*)netdev2;
+    int size = dev->rx_len;
     (void)info;
 
     if (!buf) {
         if (len > 0) {
             /* no memory available in pktbuf, discarding the frame */
             DEBUG("netdev2_tap: discarding the frame\n");
-
-            /* repeating `real_read` for small size on tap device results in
-             * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
-            }
-            */
-
-            static uint8_t buf[ETHERNET_FRAME_LEN];
-
-            real_read(dev->tap_fd, buf, sizeof(buf));
-
-            _continue_reading(dev);
+            dev->rx_len = 0;
         }
 
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
-        return ETHERNET_FRAME_LEN;
+        /* the frame was read ahead, so its exact size is known */
+        return size;
     }
 
-    int nread = real_read(dev->tap_fd, buf, len);
-    DEBUG("netdev2_tap: read %d bytes\n", nread);
-
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev2_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-
-            native_async_read_continue(dev->tap_fd);
-
-            return 0;
-        }
-
-        _continue_reading(dev);
+    if (size > len) {
+        size = len;
+    }
+    memcpy(buf, dev->rx_buf, size);
+    dev->rx_len = 0;
 
 #ifdef MODULE_NETSTATS_L2
-        netdev2->stats.rx_count++;
-        netdev2->stats.rx_bytes += nread;
+    netdev2->stats.rx_count++;
+    netdev2->stats.rx_bytes += size;
 #endif
-        return nread;
-    }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
-            err(EXIT_FAILURE, "netdev2_tap: read");
-        }
-    }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event");
-    }
-    else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
-    }
-
-    return -1;
+    return size;
 }
 
 static int _send(netdev2_t *netdev, const struct iovec *vector, int n)
@@ -16,6 +16,12 @@
  *
  * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
  *
+ * With the `native_timer_abstime` module (Linux only), every channel is
+ * backed by a POSIX per-process timer on CLOCK_MONOTONIC instead. These are
+ * armed with absolute deadlines, so timer_set_absolute() is exact to the
+ * microsecond and offsets are not clamped to NATIVE_TIMER_MIN_RES. They still
+ * expire via SIGALRM, so the timer interrupt is handled as before.
+ *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
@@ -44,6 +50,10 @@
 #include "native_internal.h"
 #include "periph/timer.h"
 
+#if defined(MODULE_NATIVE_TIMER_ABSTIME) && !defined(__linux__)
+#error "native_timer_abstime is only available on Linux"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -54,7 +64,13 @@ static unsigned long time_null;
 static timer_cb_t _callback;
 static void *_cb_arg;
 
+#ifdef MODULE_NATIVE_TIMER_ABSTIME
+static timer_t _timers[NATIVE_TIMER_CHANNELS];
+static int _timers_created;
+static volatile unsigned _armed;    /* bitmap of armed channels */
+#else
 static struct itimerval itv;
+#endif
 
 /**
  * returns ticks for give timespec
@@ -70,12 +86,38 @@ static unsigned long ts2ticks(struct timespec *tp)
  *
  * set new system timer, call timer interrupt handler
  */
+#ifdef MODULE_NATIVE_TIMER_ABSTIME
+void native_isr_timer(void)
+{
+    DEBUG("%s\n", __func__);
+
+    /* expirations of several channels may be merged into one signal */
+    for (unsigned chan = 0; chan < NATIVE_TIMER_CHANNELS; chan++) {
+        struct itimerspec its;
+
+        if (!(_armed & (1 << chan))) {
+            continue;
+        }
+        _native_syscall_enter();
+        if (timer_gettime(_timers[chan], &its) == -1) {
+            err(EXIT_FAILURE, "native_isr_timer: timer_gettime");
+        }
+        _native_syscall_leave();
+        if (its.it_value.tv_sec || its.it_value.tv_nsec) {
+            continue;
+        }
+        _armed &= ~(1 << chan);
+        _callback(_cb_arg, chan);
+    }
+}
+#else
 void native_isr_timer(void)
 {
     DEBUG("%s\n", __func__);
 
     _callback(_cb_arg, 0);
 }
+#endif
 
 int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
 {
@@ -88,6 +130,25 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
         return -1;
     }
 
+#ifdef MODULE_NATIVE_TIMER_ABSTIME
+    if (!_timers_created) {
+        for (unsigned chan = 0; chan < NATIVE_TIMER_CHANNELS; chan++) {
+            struct sigevent sev;
+
+            memset(&sev, 0, sizeof(sev));
+            sev.sigev_notify = SIGEV_SIGNAL;
+            sev.sigev_signo = SIGALRM;
+            sev.sigev_value.sival_int = chan;
+            _native_syscall_enter();
+            if (timer_create(CLOCK_MONOTONIC, &sev, &_timers[chan]) == -1) {
+                err(EXIT_FAILURE, "timer_init: timer_create");
+            }
+            _native_syscall_leave();
+        }
+        _timers_created = 1;
+    }
+#endif
+
     /* initialize time delta */
     time_null = 0;
     time_null = timer_read(0);
@@ -100,6 +161,95 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
     return 0;
 }
 
+#ifdef MODULE_NATIVE_TIMER_ABSTIME
+/**
+ * returns the current CLOCK_MONOTONIC time in microseconds
+ */
+static uint64_t _now_us(void)
+{
+    struct timespec t;
+
+    _native_syscall_enter();
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "timer: clock_gettime");
+    }
+    _native_syscall_leave();
+
+    return ((uint64_t)t.tv_sec * NATIVE_TIMER_SPEED) + (t.tv_nsec / 1000);
+}
+
+/**
+ * arms a channel to expire at the given CLOCK_MONOTONIC time, disarms it if
+ * deadline is 0
+ */
+static void do_timer_set(int channel, uint64_t deadline)
+{
+    struct itimerspec its;
+
+    DEBUG("%s\n", __func__);
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = deadline / NATIVE_TIMER_SPEED;
+    its.it_value.tv_nsec = (deadline % NATIVE_TIMER_SPEED) * 1000;
+
+    DEBUG("timer_set(): setting %u.%06u\n", (unsigned)its.it_value.tv_sec,
+          (unsigned)(its.it_value.tv_nsec / 1000));
+
+    _native_syscall_enter();
+    if (deadline) {
+        _armed |= (1 << channel);
+    }
+    else {
+        _armed &= ~(1 << channel);
+    }
+    if (timer_settime(_timers[channel], TIMER_ABSTIME, &its, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: timer_settime");
+    }
+    _native_syscall_leave();
+}
+
+int timer_set(tim_t dev, int channel, unsigned int offset)
+{
+    DEBUG("%s\n", __func__);
+
+    if ((dev >= TIMER_NUMOF) || ((unsigned)channel >= NATIVE_TIMER_CHANNELS)) {
+        return -1;
+    }
+
+    do_timer_set(channel, _now_us() + offset);
+
+    return 1;
+}
+
+int timer_set_absolute(tim_t dev, int channel, unsigned int value)
+{
+    DEBUG("%s\n", __func__);
+
+    if ((dev >= TIMER_NUMOF) || ((unsigned)channel >= NATIVE_TIMER_CHANNELS)) {
+        return -1;
+    }
+
+    /* like a hardware compare, value is reached when the counter next
+     * passes it, which for a value just passed is after a full wrap */
+    uint64_t now = _now_us();
+    uint32_t ticks = (uint32_t)(now - time_null);
+
+    do_timer_set(channel, now + (uint32_t)(value - ticks));
+
+    return 1;
+}
+
+int timer_clear(tim_t dev, int channel)
+{
+    if ((dev >= TIMER_NUMOF) || ((unsigned)channel >= NATIVE_TIMER_CHANNELS)) {
+        return -1;
+    }
+
+    do_timer_set(channel, 0);
+
+    return 1;
+}
+#else
 static void do_timer_set(unsigned int offset)
 {
     DEBUG("%s\n", __func__);
@@ -155,6 +305,8 @@ int timer_clear(tim_t dev, int channel)
     return 1;
 }
 
+#endif
+
 void timer_irq_enable(tim_t dev)
 {
     (void)dev;
@@ -126,9 +126,12 @@ void _native_syscall_leave(void)
         native_isr_context.uc_stack.ss_size = SIGSTKSZ;
         native_isr_context.uc_stack.ss_flags = 0;
         makecontext(&native_isr_context, native_irq_handler, 0);
-        if (swapcontext(_native_cur_ctx, &native_isr_context) == -1) {
+        if (native_swapcontext(_native_cur_ctx, &native_isr_context) == -1) {
             err(EXIT_FAILURE, "_native_syscall_leave: swapcontext");
         }
+#ifdef MODULE_NATIVE_VIRQ
+        _native_in_isr = 0;
+#endif
         irq_restore(mask);
     }
 }
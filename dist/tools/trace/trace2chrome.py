@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2016 agent <agent@local>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Converts the output of the `trace dump` shell command to Chrome trace JSON.
+
+Usage: trace2chrome.py [dump.txt] [-o trace.json]
+
+The input may contain arbitrary other lines (e.g. a complete terminal log),
+only lines containing "TRACE" records are evaluated. The result can be
+opened in chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import sys
+
+TRACE_SCHED = 0
+TRACE_MSG_SEND = 1
+TRACE_MSG_RECEIVE = 2
+TRACE_MUTEX_BLOCK = 3
+TRACE_MUTEX_UNBLOCK = 4
+TRACE_XTIMER_FIRE = 5
+TRACE_ISR_ENTER = 6
+TRACE_ISR_EXIT = 7
+TRACE_USER = 8
+
+NAMES = {
+    TRACE_MSG_SEND: "msg_send",
+    TRACE_MSG_RECEIVE: "msg_receive",
+    TRACE_MUTEX_BLOCK: "mutex_block",
+    TRACE_MUTEX_UNBLOCK: "mutex_unblock",
+    TRACE_XTIMER_FIRE: "xtimer_fire",
+    TRACE_USER: "user",
+}
+
+ISR_TID = -1
+
+
+def parse(lines):
+    threads = {}
+    events = []
+    for line in lines:
+        idx = line.find("TRACE ")
+        if idx < 0:
+            continue
+        fields = line[idx:].split()
+        if len(fields) >= 4 and fields[1] == "T":
+            threads[int(fields[2])] = " ".join(fields[3:])
+        elif len(fields) == 6 and fields[1] == "E":
+            events.append((int(fields[2]), int(fields[3]), int(fields[4]),
+                           int(fields[5], 16)))
+    return threads, events
+
+
+def unwrap(events):
+    """Makes the 32 bit timestamps monotonic."""
+    offset = 0
+    last = None
+    for time, pid, type_, arg in events:
+        if last is not None and time < last:
+            offset += 1 << 32
+        last = time
+        yield time + offset, pid, type_, arg
+
+
+def convert(threads, events):
+    out = []
+    for pid, name in threads.items():
+        out.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": pid,
+                    "args": {"name": name}})
+    out.append({"ph": "M", "name": "thread_name", "pid": 0, "tid": ISR_TID,
+                "args": {"name": "ISR"}})
+
+    running = None
+    since = None
+    for time, pid, type_, arg in unwrap(events):
+        if type_ == TRACE_SCHED:
+            if running is not None:
+                out.append({"ph": "X", "name": threads.get(running, str(running)),
+                            "pid": 0, "tid": running, "ts": since,
+                            "dur": time - since})
+            running = pid
+            since = time
+        elif type_ in (TRACE_ISR_ENTER, TRACE_ISR_EXIT):
+            out.append({"ph": "B" if type_ == TRACE_ISR_ENTER else "E",
+                        "name": "irq %u" % arg, "pid": 0, "tid": ISR_TID,
+                        "ts": time})
+        else:
+            if type_ in (TRACE_MSG_SEND, TRACE_MSG_RECEIVE):
+                args = {"pid": arg}
+            else:
+                args = {"arg": "0x%08x" % arg}
+            out.append({"ph": "i", "s": "t",
+                        "name": NAMES.get(type_, "event %u" % type_),
+                        "pid": 0, "tid": pid, "ts": time, "args": args})
+    return {"traceEvents": out, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin, help="trace dump (default: stdin)")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w"),
+                        default=sys.stdout, help="JSON file (default: stdout)")
+    args = parser.parse_args()
+
+    threads, events = parse(args.input)
+    json.dump(convert(threads, events), args.output)
+    print("%u events converted" % len(events), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
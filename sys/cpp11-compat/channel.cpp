@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Typed message channel on top of core_msg
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#include "irq.h"
+#include "msg.h"
+#include "assert.h"
+#include "timex.h"
+#include "xtimer.h"
+#include "bitarithm.h"
+
+#include <system_error>
+
+#include "riot/channel.hpp"
+
+using namespace std;
+
+namespace riot {
+namespace detail {
+
+namespace {
+channel_base* channels = nullptr;
+uint8_t next_id = 0;
+
+/**
+ * @brief Microseconds to wait before retrying to send to a receiver whose
+ *        message queue is full
+ */
+constexpr uint64_t post_retry_interval = 1000;
+
+/**
+ * @brief Microseconds left until @p deadline, 0 if it passed
+ */
+uint64_t remaining(const time_point& deadline) {
+  time_point current = now();
+  if (current >= deadline) {
+    return 0;
+  }
+  return timex_uint64(timex_sub(deadline.native_handle(),
+                                current.native_handle()));
+}
+} // namespace anonymous
+
+channel_base::channel_base(uint32_t* stash, unsigned size,
+                           kernel_pid_t receiver)
+    : m_receiver{receiver},
+      m_free{(size < 32) ? ((UINT32_C(1) << size) - 1) : UINT32_MAX},
+      m_waiting{0},
+      m_stash{stash},
+      m_stash_size{size},
+      m_stash_head{0},
+      m_stash_count{0} {
+  unsigned state = irq_disable();
+  // find an id that is not in use yet
+  for (unsigned tries = 0; tries <= UINT8_MAX; tries++) {
+    uint16_t type = channel_msg_type_base | next_id++;
+    channel_base* ch = channels;
+    while (ch && (ch->m_type != type)) {
+      ch = ch->m_next;
+    }
+    if (ch == nullptr) {
+      m_type = type;
+      m_next = channels;
+      channels = this;
+      irq_restore(state);
+      return;
+    }
+  }
+  irq_restore(state);
+  throw system_error(make_error_code(errc::resource_unavailable_try_again),
+                     "No channel id left.");
+}
+
+channel_base::~channel_base() {
+  unsigned state = irq_disable();
+  channel_base** ch = &channels;
+  while (*ch != this) {
+    ch = &(*ch)->m_next;
+  }
+  *ch = m_next;
+  irq_restore(state);
+}
+
+int channel_base::acquire(wait_mode mode, const time_point& deadline) {
+  unsigned state = irq_disable();
+  if (m_free) {
+    int idx = bitarithm_lsb(m_free);
+    m_free &= ~(UINT32_C(1) << idx);
+    irq_restore(state);
+    return idx;
+  }
+  irq_restore(state);
+  if (mode == wait_mode::none) {
+    return -1;
+  }
+
+  // the channel is full, wait for the receiver to release a slot
+  unique_lock<mutex> lock(m_mtx);
+  int idx = -1;
+  m_waiting++;
+  while (true) {
+    state = irq_disable();
+    if (m_free) {
+      idx = bitarithm_lsb(m_free);
+      m_free &= ~(UINT32_C(1) << idx);
+      irq_restore(state);
+      break;
+    }
+    irq_restore(state);
+    if (mode == wait_mode::forever) {
+      m_cv.wait(lock);
+    }
+    else if (m_cv.wait_until(lock, deadline) == cv_status::timeout) {
+      // the slot may have been released right before the timeout
+      state = irq_disable();
+      if (m_free) {
+        idx = bitarithm_lsb(m_free);
+        m_free &= ~(UINT32_C(1) << idx);
+      }
+      irq_restore(state);
+      break;
+    }
+  }
+  m_waiting--;
+  return idx;
+}
+
+void channel_base::release(int idx) {
+  unsigned state = irq_disable();
+  if (idx < 0) {
+    // values sent inline do not use their slot, any taken one will do
+    uint32_t taken = ~m_free;
+    if (m_stash_size < 32) {
+      taken &= (UINT32_C(1) << m_stash_size) - 1;
+    }
+    idx = bitarithm_lsb(taken);
+  }
+  m_free |= (UINT32_C(1) << idx);
+  irq_restore(state);
+  if (m_waiting) {
+    lock_guard<mutex> lock(m_mtx);
+    m_cv.notify_one();
+  }
+}
+
+bool channel_base::post(uint32_t word, wait_mode mode,
+                        const time_point& deadline) {
+  msg_t msg;
+  msg.type = m_type;
+  msg.content.value = word;
+  switch (mode) {
+    case wait_mode::forever:
+      return msg_send(&msg, m_receiver) == 1;
+    case wait_mode::none:
+      return msg_try_send(&msg, m_receiver) == 1;
+    case wait_mode::deadline:
+      break;
+  }
+  // there is no timed send, poll until the receiver's queue has room
+  while (true) {
+    int res = msg_try_send(&msg, m_receiver);
+    if (res != 0) {
+      return res == 1;
+    }
+    uint64_t us = remaining(deadline);
+    if (us == 0) {
+      return false;
+    }
+    xtimer_usleep64((us < post_retry_interval) ? us : post_retry_interval);
+  }
+}
+
+int channel_base::fetch(uint32_t& word, wait_mode mode,
+                        const time_point& deadline, msg_t* other) {
+  while (!stashed()) {
+    int res = pull(mode, deadline, other);
+    if (res <= 0) {
+      return res;
+    }
+  }
+  word = unstash();
+  return 1;
+}
+
+int channel_base::select(channel_base* const* chs, size_t numof,
+                         wait_mode mode, const time_point& deadline,
+                         msg_t* other) {
+  while (true) {
+    for (size_t i = 0; i < numof; i++) {
+      if (chs[i]->stashed()) {
+        return i;
+      }
+    }
+    int res = pull(mode, deadline, other);
+    if (res == 0) {
+      return -1;
+    }
+    if (res < 0) {
+      return select_other;
+    }
+  }
+}
+
+int channel_base::pull(wait_mode mode, const time_point& deadline,
+                       msg_t* other) {
+  kernel_pid_t me = thread_getpid();
+  msg_t msg;
+
+  while (true) {
+    switch (mode) {
+      case wait_mode::none:
+        if (msg_try_receive(&msg) < 0) {
+          return 0;
+        }
+        break;
+      case wait_mode::forever:
+        msg_receive(&msg);
+        break;
+      case wait_mode::deadline: {
+        uint64_t us = remaining(deadline);
+        if ((us == 0) && (msg_try_receive(&msg) < 0)) {
+          return 0;
+        }
+        if ((us > 0) && (xtimer_msg_receive_timeout64(&msg, us) < 0)) {
+          return 0;
+        }
+        break;
+      }
+    }
+
+    unsigned state = irq_disable();
+    channel_base* ch = channels;
+    while (ch && ((ch->m_type != msg.type) || (ch->m_receiver != me))) {
+      ch = ch->m_next;
+    }
+    irq_restore(state);
+    if (ch) {
+      ch->stash(msg.content.value);
+      return 1;
+    }
+    // not a message of one of our channels, it belongs to the caller
+    assert(other != nullptr);
+    if (other) {
+      *other = msg;
+      return -1;
+    }
+  }
+}
+
+void channel_base::stash(uint32_t word) {
+  // a channel never has more words in flight than its stash can hold
+  m_stash[(m_stash_head + m_stash_count) % m_stash_size] = word;
+  m_stash_count++;
+}
+
+uint32_t channel_base::unstash() {
+  uint32_t word = m_stash[m_stash_head];
+  m_stash_head = (m_stash_head + 1) % m_stash_size;
+  m_stash_count--;
+  return word;
+}
+
+} // namespace detail
+} // namespace riot
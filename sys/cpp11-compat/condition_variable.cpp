@@ -34,6 +34,29 @@ using namespace std::chrono;
 
 namespace riot {
 
+namespace {
+
+struct timed_wait {
+  priority_queue_node_t node;
+  priority_queue_t* queue;
+  bool timed_out;
+};
+
+// timer callback of wait_until_us(), runs in interrupt context: dequeues the
+// waiting thread unless it got notified already, and wakes it if it sleeps
+void timeout(void* arg) {
+  timed_wait* w = static_cast<timed_wait*>(arg);
+  unsigned old_state = irq_disable();
+  if (w->node.data != -1u) {
+    priority_queue_remove(w->queue, &w->node);
+    w->timed_out = true;
+    thread_wakeup(static_cast<kernel_pid_t>(w->node.data));
+  }
+  irq_restore(old_state);
+}
+
+} // namespace <anonymous>
+
 condition_variable::~condition_variable() { m_queue.first = NULL; }
 
 void condition_variable::notify_one() noexcept {
@@ -104,18 +127,58 @@ void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
 
 cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
                                          const time_point& timeout_time) {
+  return wait_until_us(lock, timex_uint64(timeout_time.native_handle()));
+}
+
+cv_status condition_variable::wait_until_us(unique_lock<mutex>& lock,
+                                            uint64_t target) {
+  if (!lock.owns_lock()) {
+    throw std::system_error(
+      std::make_error_code(std::errc::operation_not_permitted),
+      "Mutex not locked.");
+  }
+  timed_wait w;
+  w.node.priority = sched_active_thread->priority;
+  w.node.data = sched_active_pid;
+  w.node.next = NULL;
+  w.queue = &m_queue;
+  w.timed_out = false;
   xtimer_t timer;
-  // todo: use function to wait for absolute timepoint once available
-  timex_t before;
-  xtimer_now_timex(&before);
-  auto diff = timex_sub(timeout_time.native_handle(), before);
-  xtimer_set_wakeup(&timer, timex_uint64(diff), sched_active_pid);
-  wait(lock);
-  timex_t after;
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto cmp = timex_cmp(after, timeout_time.native_handle());
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  timer.target = timer.long_target = 0;
+  timer.callback = timeout;
+  timer.arg = &w;
+  unsigned old_state = irq_disable();
+  priority_queue_add(&m_queue, &w.node);
+  irq_restore(old_state);
+  // the timer is not set if the target passed already, don't sleep then
+  bool slept = false;
+  if (xtimer_set_absolute64(&timer, target) == 0) {
+    // the timer may have fired already, check and go to sleep atomically
+    // so its wakeup can't get lost in between
+    old_state = irq_disable();
+    if (!w.timed_out) {
+      mutex_unlock_and_sleep(lock.mutex()->native_handle());
+      slept = true;
+    }
+    irq_restore(old_state);
+    xtimer_remove(&timer);
+  }
+  // on signaling w.node.data is set to -1u and the timer callback dequeues
+  // the node itself, otherwise this was a spurious wakeup or the target
+  // passed before the timer was set and the node is still queued
+  old_state = irq_disable();
+  bool notified = (w.node.data == -1u);
+  if (!notified && !w.timed_out) {
+    priority_queue_remove(&m_queue, &w.node);
+  }
+  irq_restore(old_state);
+  if (slept) {
+    mutex_lock(lock.mutex()->native_handle());
+  }
+  if (notified || (!w.timed_out && (xtimer_now64() < target))) {
+    return cv_status::no_timeout;
+  }
+  return cv_status::timeout;
 }
 
 } // namespace riot
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 future and promise drop in replacements
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#include <system_error>
+
+#include "riot/future.hpp"
+
+using namespace std;
+
+namespace riot {
+namespace detail {
+
+void shared_state_base::wait() {
+  unique_lock<mutex> lock(m_mtx);
+  while (!m_ready) {
+    m_cv.wait(lock);
+  }
+}
+
+future_status shared_state_base::wait_until(const time_point& timeout_time) {
+  unique_lock<mutex> lock(m_mtx);
+  if (m_cv.wait_until(lock, timeout_time, [this] { return m_ready; })) {
+    return future_status::ready;
+  }
+  return future_status::timeout;
+}
+
+void shared_state_base::set_broken() {
+  unique_lock<mutex> lock(m_mtx);
+  if (!m_ready) {
+    m_ready = true;
+    m_broken = true;
+    m_cv.notify_all();
+  }
+}
+
+void shared_state_base::make_ready() {
+  if (m_ready) {
+    throw system_error(make_error_code(errc::operation_not_permitted),
+                       "Promise already satisfied.");
+  }
+  m_ready = true;
+}
+
+void shared_state_base::wait_value(unique_lock<mutex>& lock) {
+  while (!m_ready) {
+    m_cv.wait(lock);
+  }
+  if (m_broken) {
+    throw system_error(make_error_code(errc::owner_dead), "Broken promise.");
+  }
+}
+
+} // namespace detail
+} // namespace riot
@@ -0,0 +1,498 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Typed message channel on top of @ref core_msg
+ *
+ * A riot::channel<T, N> passes values of type T to the thread that created
+ * it (or the thread given to the constructor), without any allocation:
+ *
+ * - values of trivially copyable types that fit into msg_t::content are
+ *   copied into the message itself
+ * - larger values are moved into one of N slots that are part of the
+ *   channel, only the slot index is sent
+ *
+ * At most N values can be in flight, senders block (or fail, or time out)
+ * while the channel or the receiver's message queue is full. Every channel
+ * uses its own message type from the range starting at
+ * @ref riot::channel_msg_type_base. To wait on several channels use
+ * riot::select(). The receiving thread needs a message queue to not block
+ * senders until it receives.
+ *
+ * Threads that also get other messages (e.g. GNRC packets or timer
+ * messages) must pass a msg_t to the receiving functions. A message that
+ * does not belong to a channel ends the call and is handed back in it.
+ * Without one, the receiving thread must get nothing but channel messages.
+ *
+ * @code
+ * riot::channel<int, 4> ch;       // on the receiving thread
+ * ch.send(42);                     // on any other thread
+ * int value;
+ * ch.receive(value);
+ * @endcode
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#ifndef RIOT_CHANNEL_HPP
+#define RIOT_CHANNEL_HPP
+
+#include "msg.h"
+#include "thread.h"
+
+#include <new>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+#include "riot/mutex.hpp"
+#include "riot/chrono.hpp"
+#include "riot/condition_variable.hpp"
+
+namespace riot {
+
+/**
+ * @brief First message type used by channels, the lower 8 bit hold the
+ *        channel's id
+ */
+constexpr uint16_t channel_msg_type_base = 0xce00;
+
+/**
+ * @brief Returned by riot::select() and its variants if they received a
+ *        message that does not belong to a channel
+ */
+constexpr int select_other = -2;
+
+namespace detail {
+
+/**
+ * @brief How long to wait in channel operations
+ */
+enum class wait_mode {
+  none,       /**< don't block */
+  forever,    /**< block until done */
+  deadline    /**< block until done or the deadline passed */
+};
+
+/**
+ * @brief Slot and message handling of a channel, independent of its type
+ */
+class channel_base {
+ public:
+  channel_base(const channel_base&) = delete;
+  channel_base& operator=(const channel_base&) = delete;
+
+  /**
+   * @brief PID of the thread receiving from this channel
+   */
+  inline kernel_pid_t receiver() const noexcept { return m_receiver; }
+
+  /**
+   * @brief Waits until one of @p channels has a value
+   *
+   * @param[out] other  gets messages that do not belong to a channel, may
+   *                    be nullptr if the thread gets none
+   *
+   * @return index of the first channel in @p channels with a value
+   * @return -1 on timeout or if @p mode is wait_mode::none and none has one
+   * @return riot::select_other if a message was written to @p other
+   */
+  static int select(channel_base* const* channels, size_t numof,
+                    wait_mode mode, const time_point& deadline,
+                    msg_t* other);
+
+ protected:
+  channel_base(uint32_t* stash, unsigned size, kernel_pid_t receiver);
+  ~channel_base();
+
+  /**
+   * @brief Reserves one of the channel's slots for a value to send
+   *
+   * @return index of the slot
+   * @return -1 if the channel stayed full
+   */
+  int acquire(wait_mode mode, const time_point& deadline);
+  /**
+   * @brief Returns a slot taken from a received message
+   *
+   * @param[in] idx   index of the slot, -1 for any slot if the value was
+   *                  sent inline
+   */
+  void release(int idx);
+  /**
+   * @brief Sends @p word to the receiver
+   *
+   * @return false if the receiver does not exist anymore or, unless @p mode
+   *         is wait_mode::forever, its message queue stayed full
+   */
+  bool post(uint32_t word, wait_mode mode, const time_point& deadline);
+  /**
+   * @brief Gets the next word sent to this channel
+   *
+   * @param[out] other  gets messages that do not belong to a channel, may
+   *                    be nullptr if the thread gets none
+   *
+   * @return 1 if @p word was set
+   * @return 0 on timeout or if @p mode is wait_mode::none and there is no
+   *         word yet
+   * @return -1 if a message was written to @p other
+   */
+  int fetch(uint32_t& word, wait_mode mode, const time_point& deadline,
+            msg_t* other);
+
+ private:
+  /**
+   * @brief Receives one message and stashes it in its channel
+   *
+   * @return 1 if the message was stashed
+   * @return 0 on timeout
+   * @return -1 if the message does not belong to a channel and was written
+   *         to @p other
+   */
+  static int pull(wait_mode mode, const time_point& deadline, msg_t* other);
+  void stash(uint32_t word);
+  inline bool stashed() const { return m_stash_count > 0; }
+  uint32_t unstash();
+
+  channel_base* m_next;     /**< next channel in the list of all channels */
+  uint16_t m_type;
+  kernel_pid_t m_receiver;
+  uint32_t m_free;          /**< bitmap of free slots */
+  unsigned m_waiting;       /**< number of senders waiting for a slot */
+  mutex m_mtx;
+  condition_variable m_cv;
+  uint32_t* m_stash;        /**< words received while waiting for another
+                                 channel */
+  unsigned m_stash_size;
+  unsigned m_stash_head;
+  unsigned m_stash_count;
+};
+
+/**
+ * @brief Whether T travels in the message itself
+ */
+template <class T>
+struct channel_inline
+    : std::integral_constant<bool, (sizeof(T) <= sizeof(uint32_t))
+                                   && std::is_trivially_copyable<T>::value> {};
+
+/**
+ * @brief Storage of a channel, slots are only needed for large types
+ */
+template <class T, size_t N, bool Inline = channel_inline<T>::value>
+class channel_storage {
+ protected:
+  inline uint32_t store(unsigned idx, T&& value) {
+    new (slot(idx)) T(std::move(value));
+    return idx;
+  }
+  inline T load(uint32_t word, int& idx) {
+    idx = word;
+    T value(std::move(*slot(idx)));
+    slot(idx)->~T();
+    return value;
+  }
+
+ private:
+  inline T* slot(unsigned idx) { return reinterpret_cast<T*>(&m_slots[idx]); }
+
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_slots[N];
+};
+
+template <class T, size_t N>
+class channel_storage<T, N, true> {
+ protected:
+  inline uint32_t store(unsigned idx, T&& value) {
+    (void)idx;
+    uint32_t word = 0;
+    std::memcpy(&word, &value, sizeof(T));
+    return word;
+  }
+  inline T load(uint32_t word, int& idx) {
+    T value;
+    idx = -1;
+    std::memcpy(&value, &word, sizeof(T));
+    return value;
+  }
+};
+
+/**
+ * @brief Converts a duration into a deadline
+ */
+template <class Rep, class Period>
+inline time_point deadline_in(const std::chrono::duration<Rep, Period>& d) {
+  time_point deadline = now();
+  deadline += d;
+  return deadline;
+}
+
+} // namespace detail
+
+/**
+ * @brief Channel passing values of type @p T to one receiving thread
+ *
+ * @tparam T    type of the values, needs to be move constructible and, when
+ *              sent inline, default constructible
+ * @tparam N    number of values that can be in flight, at most 32
+ */
+template <class T, size_t N>
+class channel : public detail::channel_base,
+                private detail::channel_storage<T, N> {
+  static_assert((N > 0) && (N <= 32), "A channel holds 1 to 32 values");
+
+ public:
+  /**
+   * @brief Creates a channel to @p receiver
+   */
+  explicit channel(kernel_pid_t receiver = thread_getpid())
+      : channel_base(m_stash_storage, N, receiver) {}
+
+  /**
+   * @brief Sends @p value, blocks while the channel or the receiver's
+   *        message queue is full
+   *
+   * @return false if the receiver does not exist anymore
+   */
+  bool send(T value) {
+    return send_impl(std::move(value), detail::wait_mode::forever,
+                     time_point());
+  }
+
+  /**
+   * @brief Sends @p value if neither the channel nor the receiver's message
+   *        queue is full
+   */
+  bool try_send(T value) {
+    return send_impl(std::move(value), detail::wait_mode::none, time_point());
+  }
+
+  /**
+   * @brief Sends @p value, blocks at most @p timeout while the channel or
+   *        the receiver's message queue is full
+   */
+  template <class Rep, class Period>
+  bool send_for(T value, const std::chrono::duration<Rep, Period>& timeout) {
+    return send_impl(std::move(value), detail::wait_mode::deadline,
+                     detail::deadline_in(timeout));
+  }
+
+  /**
+   * @brief Receives a value, blocks until there is one
+   *
+   * Must be called by the receiving thread, which must not get any other
+   * messages.
+   */
+  void receive(T& value) {
+    receive_impl(value, detail::wait_mode::forever, time_point(), nullptr);
+  }
+
+  /**
+   * @brief Receives a value or another message, blocks until there is one
+   *
+   * Must be called by the receiving thread.
+   *
+   * @param[out] value  the value received
+   * @param[out] other  a message that does not belong to a channel
+   *
+   * @return true if @p value was received
+   * @return false if @p other was received
+   */
+  bool receive(T& value, msg_t& other) {
+    return receive_impl(value, detail::wait_mode::forever, time_point(),
+                        &other) > 0;
+  }
+
+  /**
+   * @brief Receives a value if there is one
+   */
+  bool try_receive(T& value) {
+    return receive_impl(value, detail::wait_mode::none, time_point(),
+                        nullptr) > 0;
+  }
+
+  /**
+   * @brief Receives a value or another message if there is one
+   *
+   * @return 1 if @p value was received
+   * @return 0 if there was nothing to receive
+   * @return -1 if @p other was received
+   */
+  int try_receive(T& value, msg_t& other) {
+    return receive_impl(value, detail::wait_mode::none, time_point(), &other);
+  }
+
+  /**
+   * @brief Receives a value, blocks at most @p timeout
+   */
+  template <class Rep, class Period>
+  bool receive_for(T& value,
+                   const std::chrono::duration<Rep, Period>& timeout) {
+    return receive_impl(value, detail::wait_mode::deadline,
+                        detail::deadline_in(timeout), nullptr) > 0;
+  }
+
+  /**
+   * @brief Receives a value or another message, blocks at most @p timeout
+   *
+   * @return 1 if @p value was received
+   * @return 0 on timeout
+   * @return -1 if @p other was received
+   */
+  template <class Rep, class Period>
+  int receive_for(T& value, const std::chrono::duration<Rep, Period>& timeout,
+                  msg_t& other) {
+    return receive_impl(value, detail::wait_mode::deadline,
+                        detail::deadline_in(timeout), &other);
+  }
+
+ private:
+  using storage = detail::channel_storage<T, N>;
+
+  bool send_impl(T&& value, detail::wait_mode mode,
+                 const time_point& deadline) {
+    int idx = acquire(mode, deadline);
+    if (idx < 0) {
+      return false;
+    }
+    uint32_t word = storage::store(idx, std::move(value));
+    if (!post(word, mode, deadline)) {
+      // destroys the value again and frees its slot
+      storage::load(word, idx);
+      release(idx);
+      return false;
+    }
+    return true;
+  }
+
+  int receive_impl(T& value, detail::wait_mode mode,
+                   const time_point& deadline, msg_t* other) {
+    uint32_t word;
+    int idx;
+    int res = fetch(word, mode, deadline, other);
+    if (res <= 0) {
+      return res;
+    }
+    value = storage::load(word, idx);
+    release(idx);
+    return 1;
+  }
+
+  uint32_t m_stash_storage[N];
+};
+
+/**
+ * @brief Waits until one of @p channels has a value
+ *
+ * Must be called by the thread receiving from all of @p channels, which
+ * must not get any other messages. Receive the value with try_receive() on
+ * the returned channel.
+ *
+ * @return index of the first channel in @p channels having a value
+ */
+template <class... Channels>
+int select(Channels&... channels) {
+  detail::channel_base* chs[] = { &channels... };
+  return detail::channel_base::select(chs, sizeof...(Channels),
+                                      detail::wait_mode::forever,
+                                      time_point(), nullptr);
+}
+
+/**
+ * @brief Waits until one of @p channels has a value or another message
+ *        arrives
+ *
+ * @param[out] other    a message that does not belong to a channel
+ *
+ * @return index of the first channel in @p channels having a value
+ * @return riot::select_other if @p other was received
+ */
+template <class... Channels>
+int select(msg_t& other, Channels&... channels) {
+  detail::channel_base* chs[] = { &channels... };
+  return detail::channel_base::select(chs, sizeof...(Channels),
+                                      detail::wait_mode::forever,
+                                      time_point(), &other);
+}
+
+/**
+ * @brief Checks if one of @p channels has a value
+ *
+ * @return index of the first channel in @p channels having a value
+ * @return -1 if none has a value
+ */
+template <class... Channels>
+int try_select(Channels&... channels) {
+  detail::channel_base* chs[] = { &channels... };
+  return detail::channel_base::select(chs, sizeof...(Channels),
+                                      detail::wait_mode::none, time_point(),
+                                      nullptr);
+}
+
+/**
+ * @brief Checks if one of @p channels has a value or another message is
+ *        pending
+ *
+ * @param[out] other    a message that does not belong to a channel
+ *
+ * @return index of the first channel in @p channels having a value
+ * @return -1 if there is nothing to receive
+ * @return riot::select_other if @p other was received
+ */
+template <class... Channels>
+int try_select(msg_t& other, Channels&... channels) {
+  detail::channel_base* chs[] = { &channels... };
+  return detail::channel_base::select(chs, sizeof...(Channels),
+                                      detail::wait_mode::none, time_point(),
+                                      &other);
+}
+
+/**
+ * @brief Waits at most @p timeout until one of @p channels has a value
+ *
+ * @return index of the first channel in @p channels having a value
+ * @return -1 on timeout
+ */
+template <class Rep, class Period, class... Channels>
+int select_for(const std::chrono::duration<Rep, Period>& timeout,
+               Channels&... channels) {
+  detail::channel_base* chs[] = { &channels... };
+  return detail::channel_base::select(chs, sizeof...(Channels),
+                                      detail::wait_mode::deadline,
+                                      detail::deadline_in(timeout), nullptr);
+}
+
+/**
+ * @brief Waits at most @p timeout until one of @p channels has a value or
+ *        another message arrives
+ *
+ * @param[out] other    a message that does not belong to a channel
+ *
+ * @return index of the first channel in @p channels having a value
+ * @return -1 on timeout
+ * @return riot::select_other if @p other was received
+ */
+template <class Rep, class Period, class... Channels>
+int select_for(const std::chrono::duration<Rep, Period>& timeout,
+               msg_t& other, Channels&... channels) {
+  detail::channel_base* chs[] = { &channels... };
+  return detail::channel_base::select(chs, sizeof...(Channels),
+                                      detail::wait_mode::deadline,
+                                      detail::deadline_in(timeout), &other);
+}
+
+} // namespace riot
+
+#endif // RIOT_CHANNEL_HPP
@@ -79,6 +79,12 @@ class condition_variable {
   condition_variable(const condition_variable&);
   condition_variable& operator=(const condition_variable&);
 
+  /**
+   * @brief Waits until notified or the absolute time @p target in
+   *        microseconds of xtimer_now64() passed
+   */
+  cv_status wait_until_us(unique_lock<mutex>& lock, uint64_t target);
+
   priority_queue_t m_queue;
 };
 
@@ -101,29 +107,30 @@ bool condition_variable::wait_until(unique_lock<mutex>& lock,
   return true;
 }
 
+namespace detail {
+/**
+ * @brief Converts a duration into microseconds, rounding up
+ */
+template <class Rep, class Period>
+inline uint64_t duration_to_us(const std::chrono::duration<Rep, Period>& d) {
+  using namespace std::chrono;
+  auto us = duration_cast<microseconds>(d);
+  if (us < d) {
+    ++us;
+  }
+  return static_cast<uint64_t>(us.count());
+}
+} // namespace detail
+
 template <class Rep, class Period>
 cv_status condition_variable::wait_for(unique_lock<mutex>& lock,
                                        const std::chrono::duration
                                        <Rep, Period>& timeout_duration) {
-  using namespace std::chrono;
-  using std::chrono::duration;
   if (timeout_duration <= timeout_duration.zero()) {
     return cv_status::timeout;
   }
-  timex_t timeout, before, after;
-  auto s = duration_cast<seconds>(timeout_duration);
-  timeout.seconds = s.count();
-  timeout.microseconds
-    = (duration_cast<microseconds>(timeout_duration - s)).count();
-  xtimer_now_timex(&before);
-  xtimer_t timer;
-  xtimer_set_wakeup(&timer, timex_uint64(timeout), sched_active_pid);
-  wait(lock);
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto passed = timex_sub(after, before);
-  auto cmp = timex_cmp(passed, timeout);
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  return wait_until_us(lock, xtimer_now64()
+                             + detail::duration_to_us(timeout_duration));
 }
 
 template <class Rep, class Period, class Predicate>
@@ -131,8 +138,16 @@ inline bool condition_variable::wait_for(unique_lock<mutex>& lock,
                                          const std::chrono::duration
                                          <Rep, Period>& timeout_duration,
                                          Predicate pred) {
-  return wait_until(lock, std::chrono::steady_clock::now() + timeout_duration,
-                    std::move(pred));
+  if (timeout_duration <= timeout_duration.zero()) {
+    return pred();
+  }
+  uint64_t target = xtimer_now64() + detail::duration_to_us(timeout_duration);
+  while (!pred()) {
+    if (wait_until_us(lock, target) == cv_status::timeout) {
+      return pred();
+    }
+  }
+  return true;
 }
 
 } // namespace riot
@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 future, promise and async drop in replacements
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *            std::future, std::promise, std::async
+ *          </a>
+ *
+ * Differences to the standard:
+ * - timed waits use the time point from our chrono header
+ * - there is no std::exception_ptr on all of our platforms, so exceptions are
+ *   not transported. If a task throws or a promise is destroyed without a
+ *   value, get() throws a std::system_error instead (broken promise)
+ * - async() always starts a new thread, see riot::thread_pool::async() for
+ *   running tasks on preallocated threads
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#ifndef RIOT_FUTURE_HPP
+#define RIOT_FUTURE_HPP
+
+#include <new>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <system_error>
+
+#include "riot/mutex.hpp"
+#include "riot/chrono.hpp"
+#include "riot/thread.hpp"
+#include "riot/condition_variable.hpp"
+
+namespace riot {
+
+enum class future_status {
+  ready,
+  timeout
+};
+
+namespace detail {
+
+/**
+ * @brief Synchronization part of the state shared by a promise and a future
+ */
+class shared_state_base {
+ public:
+  inline shared_state_base() : m_ready{false}, m_broken{false} {}
+
+  void wait();
+  future_status wait_until(const time_point& timeout_time);
+  void set_broken();
+
+ protected:
+  /**
+   * @brief Marks the state ready, throws if it was ready before
+   * @pre   m_mtx is locked by the caller
+   */
+  void make_ready();
+  /**
+   * @brief Waits for the state to become ready, throws if it is broken
+   */
+  void wait_value(unique_lock<mutex>& lock);
+
+  mutex m_mtx;
+  condition_variable m_cv;
+  bool m_ready;
+  bool m_broken;
+};
+
+template <class T>
+class shared_state : public shared_state_base {
+ public:
+  ~shared_state() {
+    if (m_ready && !m_broken) {
+      value_ptr()->~T();
+    }
+  }
+
+  template <class U>
+  void set_value(U&& value) {
+    unique_lock<mutex> lock(m_mtx);
+    make_ready();
+    new (&m_value) T(std::forward<U>(value));
+    m_cv.notify_all();
+  }
+
+  T get() {
+    unique_lock<mutex> lock(m_mtx);
+    wait_value(lock);
+    return std::move(*value_ptr());
+  }
+
+ private:
+  inline T* value_ptr() { return reinterpret_cast<T*>(&m_value); }
+
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_value;
+};
+
+template <>
+class shared_state<void> : public shared_state_base {
+ public:
+  void set_value() {
+    unique_lock<mutex> lock(m_mtx);
+    make_ready();
+    m_cv.notify_all();
+  }
+
+  void get() {
+    unique_lock<mutex> lock(m_mtx);
+    wait_value(lock);
+  }
+};
+
+/**
+ * @brief Result type of calling F with Args after decaying both
+ */
+template <class F, class... Args>
+using async_result_t = typename std::result_of<
+  typename std::decay<F>::type(typename std::decay<Args>::type...)>::type;
+
+} // namespace detail
+
+template <class T>
+class promise;
+
+namespace detail {
+template <class T>
+class promise_base;
+} // namespace detail
+
+/**
+ * @brief C++11 compliant implementation of future, however uses the time
+ *        point from our chrono header for timed waits
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *          std::future
+ *        </a>
+ */
+template <class T>
+class future {
+  friend class detail::promise_base<T>;
+
+ public:
+  inline future() noexcept = default;
+  future(const future&) = delete;
+  future(future&&) noexcept = default;
+  future& operator=(const future&) = delete;
+  future& operator=(future&&) noexcept = default;
+
+  /**
+   * @brief Waits for the value and returns it, invalidates the future
+   */
+  T get() {
+    auto state = release_state();
+    return state->get();
+  }
+
+  inline bool valid() const noexcept { return static_cast<bool>(m_state); }
+
+  void wait() const { checked_state()->wait(); }
+
+  future_status wait_until(const time_point& timeout_time) const {
+    return checked_state()->wait_until(timeout_time);
+  }
+
+  template <class Rep, class Period>
+  future_status wait_for(const std::chrono::duration<Rep, Period>& d) const {
+    time_point timeout_time = now();
+    timeout_time += d;
+    return wait_until(timeout_time);
+  }
+
+ private:
+  inline explicit future(std::shared_ptr<detail::shared_state<T>> state)
+      : m_state{std::move(state)} {}
+
+  std::shared_ptr<detail::shared_state<T>> checked_state() const {
+    if (!m_state) {
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                              "No state associated with future.");
+    }
+    return m_state;
+  }
+
+  std::shared_ptr<detail::shared_state<T>> release_state() {
+    auto state = checked_state();
+    m_state.reset();
+    return state;
+  }
+
+  std::shared_ptr<detail::shared_state<T>> m_state;
+};
+
+namespace detail {
+
+/**
+ * @brief Shared part of promise and its void specialization
+ */
+template <class T>
+class promise_base {
+ public:
+  inline promise_base()
+      : m_state{std::make_shared<shared_state<T>>()}, m_retrieved{false} {}
+  /**
+   * @brief Breaks the promise if no value was set
+   */
+  ~promise_base() {
+    if (m_state) {
+      m_state->set_broken();
+    }
+  }
+  promise_base(const promise_base&) = delete;
+  inline promise_base(promise_base&& other) noexcept
+      : m_state{std::move(other.m_state)}, m_retrieved{other.m_retrieved} {}
+  promise_base& operator=(const promise_base&) = delete;
+
+  void swap(promise_base& other) noexcept {
+    std::swap(m_state, other.m_state);
+    std::swap(m_retrieved, other.m_retrieved);
+  }
+
+  future<T> get_future() {
+    if (m_retrieved) {
+      throw std::system_error(
+        std::make_error_code(std::errc::operation_not_permitted),
+        "Future already retrieved.");
+    }
+    m_retrieved = true;
+    return future<T>(checked_state());
+  }
+
+ protected:
+  std::shared_ptr<shared_state<T>> checked_state() {
+    if (!m_state) {
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                              "No state associated with promise.");
+    }
+    return m_state;
+  }
+
+ private:
+  std::shared_ptr<shared_state<T>> m_state;
+  bool m_retrieved;
+};
+
+} // namespace detail
+
+/**
+ * @brief C++11 compliant implementation of promise, without exception
+ *        transport
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/promise">
+ *          std::promise
+ *        </a>
+ */
+template <class T>
+class promise : public detail::promise_base<T> {
+ public:
+  inline promise() = default;
+  promise(promise&&) noexcept = default;
+  promise& operator=(promise&& other) noexcept {
+    promise(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  void set_value(const T& value) { this->checked_state()->set_value(value); }
+  void set_value(T&& value) {
+    this->checked_state()->set_value(std::move(value));
+  }
+};
+
+/**
+ * @brief promise specialization for void results
+ */
+template <>
+class promise<void> : public detail::promise_base<void> {
+ public:
+  inline promise() = default;
+  promise(promise&&) noexcept = default;
+  promise& operator=(promise&& other) noexcept {
+    promise(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  void set_value() { this->checked_state()->set_value(); }
+};
+
+template <class T>
+inline void swap(promise<T>& lhs, promise<T>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+namespace detail {
+
+/**
+ * @brief Fulfills @p p with the result of calling @p f
+ *
+ * If @p f throws, the promise is left unsatisfied and breaks when destroyed.
+ */
+template <class R, class F>
+void fulfill(promise<R>& p, F& f) {
+  try {
+    p.set_value(f());
+  }
+  catch (...) {
+    // nop, the promise breaks
+  }
+}
+
+template <class F>
+void fulfill(promise<void>& p, F& f) {
+  try {
+    f();
+    p.set_value();
+  }
+  catch (...) {
+    // nop, the promise breaks
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Runs @p f with @p args on a new riot::thread
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/async">
+ *          std::async
+ *        </a>
+ *
+ * @return a future for the result of the call
+ */
+template <class F, class... Args>
+future<detail::async_result_t<F, Args...>> async(F&& f, Args&&... args) {
+  using result_type = detail::async_result_t<F, Args...>;
+  promise<result_type> p;
+  auto result = p.get_future();
+  auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+  thread t([](promise<result_type>& p, decltype(task)& task) {
+    detail::fulfill(p, task);
+  }, std::move(p), std::move(task));
+  t.detach();
+  return result;
+}
+
+} // namespace riot
+
+#endif // RIOT_FUTURE_HPP
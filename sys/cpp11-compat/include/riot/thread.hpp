@@ -25,7 +25,9 @@
 #define RIOT_THREAD_HPP
 
 #include "time.h"
+#include "timex.h"
 #include "thread.h"
+#include "xtimer.h"
 
 #include <tuple>
 #include <atomic>
@@ -140,12 +142,7 @@ void sleep_for(const std::chrono::duration<Rep, Period>& sleep_duration) {
   }
 }
 inline void sleep_until(const riot::time_point& sleep_time) {
-  mutex mtx;
-  condition_variable cv;
-  unique_lock<mutex> lk(mtx);
-  while (riot::now() < sleep_time) {
-    cv.wait_until(lk, sleep_time);
-  }
+  xtimer_sleep_until64(timex_uint64(sleep_time.native_handle()));
 }
 } // namespace this_thread
 
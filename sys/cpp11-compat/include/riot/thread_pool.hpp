@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Thread pool running tasks on preallocated worker threads
+ *
+ * Starting a riot::thread allocates its thread data including the stack on
+ * the heap and creates a new RIOT thread. For short tasks this dominates the
+ * run time. A thread_pool creates its worker threads once, with stacks that
+ * are part of the pool object, and feeds them tasks through a bounded queue.
+ *
+ * @code
+ * riot::thread_pool<2> pool;
+ * auto f = pool.async([](int i) { return i * i; }, 7);
+ * int res = f.get();
+ * @endcode
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#ifndef RIOT_THREAD_POOL_HPP
+#define RIOT_THREAD_POOL_HPP
+
+#include "thread.h"
+
+#include <memory>
+#include <utility>
+#include <functional>
+
+#include "riot/mutex.hpp"
+#include "riot/future.hpp"
+#include "riot/condition_variable.hpp"
+
+namespace riot {
+
+/**
+ * @brief Worker and queue handling of a thread_pool, independent of its sizes
+ */
+class thread_pool_base {
+ public:
+  using task_type = std::function<void()>;
+
+  thread_pool_base(const thread_pool_base&) = delete;
+  thread_pool_base& operator=(const thread_pool_base&) = delete;
+
+  /**
+   * @brief Queues @p task, blocks while the queue is full
+   */
+  template <class F>
+  void submit(F&& task) {
+    push(task_type(std::forward<F>(task)), true);
+  }
+
+  /**
+   * @brief Queues @p task if there is space left in the queue
+   *
+   * @return true, if the task was queued
+   */
+  template <class F>
+  bool try_submit(F&& task) {
+    return push(task_type(std::forward<F>(task)), false);
+  }
+
+  /**
+   * @brief Runs @p f with @p args on one of the workers, blocks while the
+   *        queue is full
+   *
+   * @return a future for the result of the call
+   */
+  template <class F, class... Args>
+  future<detail::async_result_t<F, Args...>> async(F&& f, Args&&... args) {
+    using result_type = detail::async_result_t<F, Args...>;
+    // std::function needs copyable tasks
+    auto p = std::make_shared<promise<result_type>>();
+    auto result = p->get_future();
+    auto call = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+    submit([p, call]() mutable { detail::fulfill(*p, call); });
+    return result;
+  }
+
+  /**
+   * @brief Number of worker threads
+   */
+  inline size_t size() const noexcept { return m_workers; }
+
+ protected:
+  thread_pool_base(task_type* queue, size_t queue_size);
+  ~thread_pool_base() = default;
+
+  /**
+   * @brief Starts @p workers threads using the stacks in @p stacks
+   */
+  void start(char* stacks, size_t stack_size, size_t workers, uint8_t prio);
+  /**
+   * @brief Runs all queued tasks and waits for the workers to exit
+   */
+  void shutdown();
+
+ private:
+  bool push(task_type&& task, bool block);
+  static void* worker(void* arg);
+
+  mutex m_mtx;
+  condition_variable m_not_empty;
+  condition_variable m_not_full;
+  task_type* m_queue;
+  size_t m_capacity;
+  size_t m_head;
+  size_t m_count;
+  size_t m_workers;
+  size_t m_running;
+  kernel_pid_t m_joining_thread;
+  bool m_stop;
+};
+
+/**
+ * @brief Thread pool with @p Workers threads and a queue for @p QueueSize
+ *        tasks
+ *
+ * The destructor runs all queued tasks before it returns.
+ *
+ * @tparam Workers      number of worker threads
+ * @tparam QueueSize    number of tasks that can be queued
+ * @tparam StackSize    stack size of each worker thread
+ */
+template <size_t Workers, size_t QueueSize = 8,
+          size_t StackSize = THREAD_STACKSIZE_MAIN>
+class thread_pool : public thread_pool_base {
+  static_assert(Workers > 0, "A thread pool needs at least one worker");
+  static_assert(QueueSize > 0, "A thread pool needs a queue");
+
+ public:
+  /**
+   * @brief Starts the workers with priority @p prio
+   */
+  explicit thread_pool(uint8_t prio = THREAD_PRIORITY_MAIN - 1)
+      : thread_pool_base(m_queue_storage, QueueSize) {
+    start(&m_stacks[0][0], StackSize, Workers, prio);
+  }
+  ~thread_pool() { shutdown(); }
+
+ private:
+  task_type m_queue_storage[QueueSize];
+  char m_stacks[Workers][StackSize];
+};
+
+} // namespace riot
+
+#endif // RIOT_THREAD_POOL_HPP
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Thread pool running tasks on preallocated worker threads
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#include <system_error>
+
+#include "riot/thread_pool.hpp"
+
+using namespace std;
+
+namespace riot {
+
+thread_pool_base::thread_pool_base(task_type* queue, size_t queue_size)
+    : m_queue{queue},
+      m_capacity{queue_size},
+      m_head{0},
+      m_count{0},
+      m_workers{0},
+      m_running{0},
+      m_joining_thread{KERNEL_PID_UNDEF},
+      m_stop{false} {
+  // nop
+}
+
+void thread_pool_base::start(char* stacks, size_t stack_size, size_t workers,
+                             uint8_t prio) {
+  for (size_t i = 0; i < workers; i++) {
+    unsigned state = irq_disable();
+    m_running++;
+    irq_restore(state);
+    kernel_pid_t pid = thread_create(stacks + (i * stack_size), stack_size,
+                                     prio, 0, &thread_pool_base::worker, this,
+                                     "riot_cpp_worker");
+    if (pid < 0) {
+      state = irq_disable();
+      m_running--;
+      irq_restore(state);
+      shutdown();
+      throw system_error(
+        make_error_code(errc::resource_unavailable_try_again),
+        "Failed to create worker thread.");
+    }
+    m_workers++;
+  }
+}
+
+void thread_pool_base::shutdown() {
+  {
+    lock_guard<mutex> lock(m_mtx);
+    m_stop = true;
+  }
+  m_not_empty.notify_all();
+  // the workers exit when the queue is empty, their stacks have to stay
+  // valid until they did
+  while (true) {
+    unsigned state = irq_disable();
+    if (m_running == 0) {
+      irq_restore(state);
+      break;
+    }
+    m_joining_thread = sched_active_pid;
+    sched_set_status((thread_t*)sched_active_thread, STATUS_SLEEPING);
+    irq_restore(state);
+    thread_yield_higher();
+  }
+}
+
+bool thread_pool_base::push(task_type&& task, bool block) {
+  unique_lock<mutex> lock(m_mtx);
+  if (m_stop) {
+    throw system_error(make_error_code(errc::operation_not_permitted),
+                       "Thread pool is shutting down.");
+  }
+  while (m_count == m_capacity) {
+    if (!block) {
+      return false;
+    }
+    m_not_full.wait(lock);
+  }
+  m_queue[(m_head + m_count) % m_capacity] = std::move(task);
+  m_count++;
+  lock.unlock();
+  m_not_empty.notify_one();
+  return true;
+}
+
+void* thread_pool_base::worker(void* arg) {
+  auto pool = static_cast<thread_pool_base*>(arg);
+  while (true) {
+    task_type task;
+    {
+      unique_lock<mutex> lock(pool->m_mtx);
+      while ((pool->m_count == 0) && !pool->m_stop) {
+        pool->m_not_empty.wait(lock);
+      }
+      if (pool->m_count == 0) {
+        break;
+      }
+      task = std::move(pool->m_queue[pool->m_head]);
+      pool->m_head = (pool->m_head + 1) % pool->m_capacity;
+      pool->m_count--;
+    }
+    pool->m_not_full.notify_one();
+    try {
+      task();
+    }
+    catch (...) {
+      // nop, tasks from async() report through their future
+    }
+  }
+  // leave with interrupts disabled, so the pool is not destroyed before this
+  // thread stopped using its stack
+  irq_disable();
+  if ((--pool->m_running == 0) &&
+      (pool->m_joining_thread != KERNEL_PID_UNDEF)) {
+    thread_t* joining = (thread_t*)sched_threads[pool->m_joining_thread];
+    if (joining && (joining->status == STATUS_SLEEPING)) {
+      sched_set_status(joining, STATUS_PENDING);
+    }
+  }
+  sched_task_exit();
+  return nullptr;
+}
+
+} // namespace riot
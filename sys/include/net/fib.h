@@ -11,6 +11,11 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * With the `fib_trie` module single hop tables are additionally indexed by a
+ * prefix trie, so the longest matching prefix is found in O(address length).
+ * Such tables need a pool of @ref FIB_TRIE_NODES_NUMOF(size) nodes in
+ * fib_table_t::trie_nodes.
+ *
  * @{
  *
  * @file
@@ -53,6 +53,32 @@ typedef struct {
     universal_address_container_t *next_hop;
 } fib_entry_t;
 
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+/**
+ * @brief Node of the prefix trie indexing the entries of a FIB table
+ *        (module `fib_trie`)
+ */
+typedef struct fib_trie_node {
+    /** sub-tries by the first bit following the key */
+    struct fib_trie_node *child[2];
+    /** parent node, NULL for the root */
+    struct fib_trie_node *parent;
+    /** nodes of further entries with the same key (not part of the trie) */
+    struct fib_trie_node *same;
+    /** entry with this key, NULL for pure branching nodes */
+    fib_entry_t *entry;
+    /** number of significant bits in key */
+    uint16_t len;
+    /** the address size in bytes, followed by the address */
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE + 1];
+} fib_trie_node_t;
+
+/**
+ * @brief Number of trie nodes required for a FIB table with @p size entries
+ */
+#define FIB_TRIE_NODES_NUMOF(size)  (2 * (size))
+#endif
+
 /**
 * @brief Container descriptor for a FIB source route entry
 */
@@ -133,6 +159,24 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** incremented on every change of the entries.
+    *   Lets users caching lookup results detect that they are stale
+    */
+    uint32_t generation;
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** pool of FIB_TRIE_NODES_NUMOF(size) trie nodes for single hop tables.
+    *   Used to find the longest matching prefix in O(address length)
+    */
+    fib_trie_node_t *trie_nodes;
+    /** root of the prefix trie */
+    fib_trie_node_t *trie_root;
+    /** list of unused trie nodes */
+    fib_trie_node_t *trie_free;
+    /** earliest lifetime of all entries.
+    *   Expired entries are removed in one sweep once it passed
+    */
+    uint64_t next_expiry;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -34,6 +34,7 @@
 #include "thread.h"
 
 #include "net/ipv6.h"
+#include "net/gnrc/ipv6/dc.h"
 #include "net/gnrc/ipv6/ext.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/ipv6/nc.h"
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_dc  IPv6 destination cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Remembers the outcome of next hop determination and source
+ *              address selection per destination.
+ *
+ * The destination cache (see
+ * <a href="https://tools.ietf.org/html/rfc4861#section-5.1">
+ *     RFC 4861, section 5.1
+ * </a>) lets packets to a recently used destination skip the forwarding
+ * table, the neighbor cache and source address selection.
+ *
+ * Entries are not updated when the information they were derived from
+ * changes. Instead, all entries become invalid at once, either when
+ * @ref gnrc_ipv6_dc_invalidate() is called (by the neighbor cache, neighbor
+ * discovery and the interface address list on every change) or when the
+ * generation of @ref gnrc_ipv6_fib_table changed. Changes that are only
+ * driven by time, like expiring prefixes or routes, are bounded by
+ * @ref GNRC_IPV6_DC_LIFETIME.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Destination cache definitions.
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef GNRC_IPV6_DC_H_
+#define GNRC_IPV6_DC_H_
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef GNRC_IPV6_DC_SIZE
+/**
+ * @brief   The size of the destination cache
+ */
+#define GNRC_IPV6_DC_SIZE           (8)
+#endif
+
+#ifndef GNRC_IPV6_DC_HASH_BUCKETS
+/**
+ * @brief   The number of hash buckets to look up destination cache entries in
+ */
+#define GNRC_IPV6_DC_HASH_BUCKETS   (GNRC_IPV6_DC_SIZE)
+#endif
+
+#ifndef GNRC_IPV6_DC_LIFETIME
+/**
+ * @brief   Time in microseconds a destination cache entry is used at most
+ *          before next hop determination is done again
+ */
+#define GNRC_IPV6_DC_LIFETIME       (1U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Destination cache entry
+ */
+typedef struct gnrc_ipv6_dc {
+    struct gnrc_ipv6_dc *next;  /**< next entry in the same hash bucket */
+    ipv6_addr_t dst;            /**< the destination */
+    /**
+     * @brief   source address selected for gnrc_ipv6_dc_t::dst
+     *
+     * Unspecified if no source address was selected.
+     */
+    ipv6_addr_t src;
+    uint32_t generation;        /**< cache generation the entry belongs to */
+    uint32_t expires;           /**< time the entry becomes invalid */
+    /**
+     * @brief   interface the packet was requested to be sent over or
+     *          KERNEL_PID_UNDEF for any interface
+     */
+    kernel_pid_t req_iface;
+    kernel_pid_t iface;         /**< interface to the next hop */
+    uint8_t l2_addr_len;        /**< length of gnrc_ipv6_dc_t::l2_addr */
+    /**
+     * @brief   link layer address of the next hop
+     */
+    uint8_t l2_addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+} gnrc_ipv6_dc_t;
+
+#if defined(MODULE_GNRC_IPV6_DC) || defined(DOXYGEN)
+/**
+ * @brief   Removes all entries from the destination cache.
+ */
+void gnrc_ipv6_dc_init(void);
+
+/**
+ * @brief   Adds the outcome of next hop determination for @p dst to the
+ *          destination cache.
+ *
+ * An entry with the same @p req_iface and @p dst is overwritten. Otherwise
+ * the oldest entry is replaced if the cache is full.
+ *
+ * The entry belongs to the cache generation seen by the last call of
+ * @ref gnrc_ipv6_dc_get(), so it is invalid right away if the cache was
+ * invalidated during next hop determination in between.
+ *
+ * @note    Must only be called from the IPv6 thread.
+ *
+ * @param[in] req_iface     The interface the packet was requested to be sent
+ *                          over. KERNEL_PID_UNDEF for any interface.
+ * @param[in] dst           The destination.
+ * @param[in] src           The source address selected for @p dst. May be
+ *                          NULL or the unspecified address if none was.
+ * @param[in] iface         The interface to the next hop.
+ * @param[in] l2_addr       The link layer address of the next hop.
+ * @param[in] l2_addr_len   Length of @p l2_addr. Must not exceed
+ *                          @ref GNRC_IPV6_NC_L2_ADDR_MAX.
+ *
+ * @return  The new destination cache entry.
+ */
+gnrc_ipv6_dc_t *gnrc_ipv6_dc_add(kernel_pid_t req_iface, const ipv6_addr_t *dst,
+                                 const ipv6_addr_t *src, kernel_pid_t iface,
+                                 const uint8_t *l2_addr, uint8_t l2_addr_len);
+
+/**
+ * @brief   Gets a valid destination cache entry.
+ *
+ * @note    Must only be called from the IPv6 thread.
+ *
+ * @param[in] req_iface The interface the packet is requested to be sent
+ *                      over. KERNEL_PID_UNDEF for any interface.
+ * @param[in] dst       The destination.
+ *
+ * @return  The destination cache entry for @p req_iface and @p dst.
+ * @return  NULL, if there is none or it was invalidated.
+ */
+gnrc_ipv6_dc_t *gnrc_ipv6_dc_get(kernel_pid_t req_iface, const ipv6_addr_t *dst);
+
+/**
+ * @brief   Invalidates all destination cache entries.
+ *
+ * Must be called whenever information next hop determination or source
+ * address selection depends on changes. Safe to be called from any thread.
+ */
+void gnrc_ipv6_dc_invalidate(void);
+#else
+#define gnrc_ipv6_dc_invalidate()   (void)0
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_IPV6_DC_H_ */
+/** @} */
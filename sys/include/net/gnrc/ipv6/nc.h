@@ -44,6 +44,15 @@ extern "C" {
 #define GNRC_IPV6_NC_SIZE           (GNRC_NETIF_NUMOF * 8)
 #endif
 
+#ifndef GNRC_IPV6_NC_HASH_BUCKETS
+/**
+ * @brief   The number of hash buckets to look up neighbor cache entries in
+ *
+ * @note    Only used with module `gnrc_ipv6_nc_hash`
+ */
+#define GNRC_IPV6_NC_HASH_BUCKETS   (GNRC_IPV6_NC_SIZE)
+#endif
+
 #ifndef GNRC_IPV6_NC_L2_ADDR_MAX
 /**
  * @brief   The maximum size of a link layer address
@@ -119,7 +128,7 @@ extern "C" {
  *              RFC 4861, section 5.1
  *          </a>.
  */
-typedef struct {
+typedef struct gnrc_ipv6_nc {
 #ifdef MODULE_GNRC_NDP_NODE
     gnrc_pktqueue_t *pkts;                      /**< Packets waiting for address resolution */
 #endif
@@ -163,6 +172,13 @@ typedef struct {
 #endif
 
     uint8_t probes_remaining;               /**< remaining number of unanswered probes */
+
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    struct gnrc_ipv6_nc *next;              /**< next entry in hash bucket or list of
+                                             *   free entries */
+    struct gnrc_ipv6_nc *older;             /**< entry used less recently */
+    struct gnrc_ipv6_nc *newer;             /**< entry used more recently */
+#endif
     /**
      * @}
      */
@@ -183,6 +199,10 @@ void gnrc_ipv6_nc_init(void);
  *                          to GNRC_IPV6_L2_ADDR_MAX. 0 if unknown.
  * @param[in] flags         Flags for the entry
  *
+ * @note    With module `gnrc_ipv6_nc_hash` a full neighbor cache replaces the
+ *          least recently used entry that is managed by NDP and neither a
+ *          router nor registered by 6LoWPAN-ND.
+ *
  * @return  Pointer to new neighbor cache entry on success
  * @return  NULL, on failure
  */
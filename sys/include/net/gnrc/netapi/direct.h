@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netapi_direct  Single-thread stack mode
+ * @ingroup     net_gnrc_netapi
+ * @brief       Runs the GNRC protocol layers run-to-completion in one thread
+ *
+ * @details     With the `gnrc_netapi_direct` module, the 6LoWPAN, IPv6 and
+ *              UDP layers do not start threads of their own. Instead they
+ *              register a message handler with a single shared stack thread
+ *              and all of them share its PID. When a layer passes a packet to
+ *              another layer using @ref net_gnrc_netapi, the packet is put
+ *              into the stack's event queue instead of being sent as a
+ *              message, and the receiving layer's handler is called as soon
+ *              as the current handler returned. So a packet traverses the
+ *              stack without a context switch, while every layer still runs
+ *              to completion before the next one sees the packet.
+ *
+ *              Packets that enter the stack from other threads (network
+ *              devices, applications) go through the same event queue. Timer
+ *              messages addressed to a layer are offered to the handlers by
+ *              message type. Applications still receive their packets as
+ *              messages.
+ *
+ *              Layers not listed above (e.g. RPL) keep their own threads.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Single-thread stack mode definitions
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_NETAPI_DIRECT_H_
+#define GNRC_NETAPI_DIRECT_H_
+
+#include <stdbool.h>
+
+#include "kernel_types.h"
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default stack size to use for the stack thread
+ */
+#ifndef GNRC_NETAPI_DIRECT_STACK_SIZE
+#define GNRC_NETAPI_DIRECT_STACK_SIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Default priority for the stack thread
+ */
+#ifndef GNRC_NETAPI_DIRECT_PRIO
+#define GNRC_NETAPI_DIRECT_PRIO             (THREAD_PRIORITY_MAIN - 3)
+#endif
+
+/**
+ * @brief   Default message queue size to use for the stack thread
+ */
+#ifndef GNRC_NETAPI_DIRECT_MSG_QUEUE_SIZE
+#define GNRC_NETAPI_DIRECT_MSG_QUEUE_SIZE   (16U)
+#endif
+
+/**
+ * @brief   Number of packets the event queue can hold, must be a power of two
+ */
+#ifndef GNRC_NETAPI_DIRECT_EVENT_QUEUE_SIZE
+#define GNRC_NETAPI_DIRECT_EVENT_QUEUE_SIZE (16U)
+#endif
+
+/**
+ * @brief   Maximum number of layers sharing the stack thread
+ */
+#ifndef GNRC_NETAPI_DIRECT_LAYER_NUMOF
+#define GNRC_NETAPI_DIRECT_LAYER_NUMOF      (4U)
+#endif
+
+/**
+ * @brief   @ref core_msg type to wake up the stack thread when packets were
+ *          put into an empty event queue
+ */
+#define GNRC_NETAPI_DIRECT_MSG_TYPE_EVENT   (0x0207)
+
+/**
+ * @brief   Message handler of a layer
+ *
+ * Is called on the stack thread with @ref GNRC_NETAPI_MSG_TYPE_RCV and
+ * @ref GNRC_NETAPI_MSG_TYPE_SND messages for the layer's type and with all
+ * other messages the stack thread receives, until one handler accepts them.
+ *
+ * @param[in] msg   the message
+ *
+ * @return  true, if the handler knows the message type
+ * @return  false, otherwise
+ */
+typedef bool (*gnrc_netapi_direct_handler_t)(msg_t *msg);
+
+/**
+ * @brief   PID of the stack thread, KERNEL_PID_UNDEF if not started yet
+ */
+extern kernel_pid_t gnrc_netapi_direct_pid;
+
+/**
+ * @brief   Registers a layer with the stack thread
+ *
+ * Starts the stack thread on first call and registers it in
+ * @ref net_gnrc_netreg for all packets of @p type.
+ *
+ * @param[in] type      the type of packets the layer handles
+ * @param[in] handler   the layer's message handler
+ *
+ * @return  PID of the stack thread
+ * @return  KERNEL_PID_UNDEF, if no more layers can be registered
+ */
+kernel_pid_t gnrc_netapi_direct_register(gnrc_nettype_t type,
+                                         gnrc_netapi_direct_handler_t handler);
+
+/**
+ * @brief   Passes a packet to a layer on the stack thread
+ *
+ * The packet is put into the event queue and handed to the layer on the
+ * stack thread. When called from the stack thread itself, this happens as
+ * soon as the current handler returned. This is called by
+ * @ref net_gnrc_netapi for packets addressed to @ref gnrc_netapi_direct_pid
+ * and should not be needed otherwise.
+ *
+ * @param[in] type  type of the layer, if GNRC_NETTYPE_UNDEF the layer is
+ *                  derived from the packet's headers
+ * @param[in] cmd   @ref GNRC_NETAPI_MSG_TYPE_RCV or
+ *                  @ref GNRC_NETAPI_MSG_TYPE_SND
+ * @param[in] pkt   the packet
+ *
+ * @return  1, if the packet was queued
+ * @return  0, if the event queue is full
+ */
+int gnrc_netapi_direct_put(gnrc_nettype_t type, uint16_t cmd,
+                           gnrc_pktsnip_t *pkt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_NETAPI_DIRECT_H_ */
+/** @} */
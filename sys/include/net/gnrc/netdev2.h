@@ -39,6 +39,11 @@ extern "C" {
 
 /**
  * @brief   Type for @ref msg_t if device fired an event
+ *
+ * @note    The gnrc_netdev2 thread itself signals device interrupts with a
+ *          thread flag, so bursts of interrupts are coalesced instead of
+ *          filling up its message queue. Messages of this type are still
+ *          handled.
  */
 #define NETDEV2_MSG_TYPE_EVENT 0x1234
 
@@ -31,6 +31,19 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets per protocol type when using module
+ *          `gnrc_netreg_hash`.
+ *
+ * @details With `gnrc_netreg_hash` the registry is a hash table keyed by
+ *          type and demux context, so gnrc_netreg_lookup(), gnrc_netreg_num(),
+ *          and gnrc_netreg_getnext() don't depend on the total number of
+ *          registrations. Must be a power of 2.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (16U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
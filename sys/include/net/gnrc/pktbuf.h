@@ -59,6 +59,41 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Size classes of the `gnrc_pktbuf_slab` implementation
+ *
+ * @details `gnrc_pktbuf_slab` replaces the first-fit allocation of
+ *          `gnrc_pktbuf_static` by free lists of fixed size chunks: one for
+ *          packet snip headers and three for payloads. A request is served
+ *          from the smallest class fitting it, or from the next larger class
+ *          if that one is exhausted. The default configuration uses about
+ *          the memory of the default @ref GNRC_PKTBUF_SIZE.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (32U)   /**< number of snip headers */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define GNRC_PKTBUF_SLAB_SMALL_SIZE     (64U)   /**< size of small chunks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define GNRC_PKTBUF_SLAB_SMALL_NUMOF    (16U)   /**< number of small chunks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_SIZE
+#define GNRC_PKTBUF_SLAB_MEDIUM_SIZE    (256U)  /**< size of medium chunks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_NUMOF
+#define GNRC_PKTBUF_SLAB_MEDIUM_NUMOF   (4U)    /**< number of medium chunks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define GNRC_PKTBUF_SLAB_LARGE_SIZE     (1536U) /**< size of large chunks (fits
+                                                 *   an Ethernet frame) */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define GNRC_PKTBUF_SLAB_LARGE_NUMOF    (2U)    /**< number of large chunks */
+#endif
+/** @} */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -271,7 +306,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes. With
+ *          `gnrc_pktbuf_slab` they are given per size class, including
+ *          allocation failures, allocations served by a larger class and the
+ *          bytes lost to internal fragmentation.
  */
 void gnrc_pktbuf_stats(void);
 #endif
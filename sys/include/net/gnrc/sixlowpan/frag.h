@@ -42,6 +42,28 @@ extern "C" {
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_SND    (0x0225)
 
+/**
+ * @brief   Number of datagrams that can wait for fragmentation at the same
+ *          time
+ *
+ * Datagrams are fragmented one after another in the order they were sent.
+ * Datagrams exceeding this number are dropped.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_JOB_NUMOF
+#define GNRC_SIXLOWPAN_FRAG_JOB_NUMOF  (4U)
+#endif
+
+/**
+ * @brief   Maximum number of fragments sent per @ref GNRC_SIXLOWPAN_MSG_FRAG_SND
+ *          message
+ *
+ * Other messages to the 6LoWPAN thread are handled in between each batch of
+ * fragments.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_BUDGET
+#define GNRC_SIXLOWPAN_FRAG_BUDGET     (4U)
+#endif
+
 /**
  * @brief   Definition of 6LoWPAN fragmentation type.
  */
@@ -51,15 +73,36 @@ typedef struct {
     size_t datagram_size;   /**< Length of just the IPv6 packet to be fragmented */
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
+    uint16_t tag;           /**< Datagram tag of all fragments of the datagram */
 } gnrc_sixlowpan_msg_frag_t;
 
 /**
- * @brief   Sends a packet fragmented.
+ * @brief   Queues a packet for fragmentation.
+ *
+ * Sends a @ref GNRC_SIXLOWPAN_MSG_FRAG_SND message to the calling thread if
+ * no fragmentation is ongoing, so the fragments are sent by
+ * gnrc_sixlowpan_frag_send() when it is handled.
+ *
+ * @param[in] pid           PID of the interface to send over
+ * @param[in] pkt           The packet to fragment, starting with its netif
+ *                          header.
+ * @param[in] datagram_size Length of the uncompressed IPv6 packet
+ *
+ * @return  true, if the packet was queued; @p pkt is released when sent.
+ * @return  false, if there are @ref GNRC_SIXLOWPAN_FRAG_JOB_NUMOF packets
+ *          queued already; @p pkt is left to the caller.
+ */
+bool gnrc_sixlowpan_frag_enqueue(kernel_pid_t pid, gnrc_pktsnip_t *pkt,
+                                 size_t datagram_size);
+
+/**
+ * @brief   Sends up to @ref GNRC_SIXLOWPAN_FRAG_BUDGET fragments of the
+ *          queued packets.
  *
- * @param[in] fragment_msg    Message containing status of the 6LoWPAN
- *                            fragmentation progress
+ * Handles a @ref GNRC_SIXLOWPAN_MSG_FRAG_SND message. Sends another one to
+ * the calling thread if packets are left in the queue.
  */
-void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
+void gnrc_sixlowpan_frag_send(void);
 
 /**
  * @brief   Handles a packet containing a fragment header.
@@ -29,6 +29,15 @@
 extern "C" {
 #endif
 
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+/**
+ * @brief   Number of flows to keep compressed header templates for
+ *
+ * @note    Only used with module `gnrc_sixlowpan_iphc_cache`
+ */
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE  (4)
+#endif
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -52,6 +61,16 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 /**
  * @brief   Compresses a 6LoWPAN for IPHC.
  *
+ * With module `gnrc_sixlowpan_iphc_cache` the compressed header of the last
+ * @ref GNRC_SIXLOWPAN_IPHC_CACHE_SIZE flows is kept. Packets that only differ
+ * from a previous one of their flow in payload length, hop limit or UDP
+ * checksum reuse its compressed header. A flow is identified by all other
+ * fields of the IPv6 header, the UDP ports and the interface and link layer
+ * addresses in the @ref gnrc_netif_hdr_t. The kept headers are dropped when
+ * the 6LoWPAN contexts change (see @ref gnrc_sixlowpan_ctx_generation()).
+ *
+ * @note    Must only be called from one thread at a time.
+ *
  * @param[in,out] pkt   A 6LoWPAN frame with an uncompressed IPv6 header to
  *                      send. Will be translated to an 6LoWPAN IPHC frame.
  *
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_trace Kernel event tracer
+ * @ingroup     sys
+ * @brief       Records timestamped kernel events into a ring buffer
+ *
+ * When the `trace` module is used, the kernel records context switches,
+ * message passing, mutex contention, xtimer callbacks and (on native)
+ * interrupts into a fixed size ring buffer. Once the buffer is full, the
+ * oldest events are overwritten, so the buffer always holds the most recent
+ * history.
+ *
+ * Recording an event takes a timestamp and a few stores with interrupts
+ * disabled, no formatting is done on the device. The buffer is printed with
+ * the `trace` shell command (or trace_dump()) and can be converted to the
+ * Chrome trace format with `dist/tools/trace/trace2chrome.py` for viewing
+ * in chrome://tracing or Perfetto.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracer interface
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of events in the ring buffer, must be a power of two
+ */
+#ifndef TRACE_BUFSIZE
+#define TRACE_BUFSIZE       (256U)
+#endif
+
+/**
+ * @brief   Event types
+ *
+ * The meaning of trace_event_t::arg depends on the type.
+ */
+typedef enum {
+    TRACE_SCHED = 0,        /**< context switch, arg: previously active PID */
+    TRACE_MSG_SEND,         /**< message sent, arg: target PID */
+    TRACE_MSG_RECEIVE,      /**< message received, arg: sender PID */
+    TRACE_MUTEX_BLOCK,      /**< thread blocked on mutex, arg: mutex address */
+    TRACE_MUTEX_UNBLOCK,    /**< mutex handed to waiter, arg: mutex address */
+    TRACE_XTIMER_FIRE,      /**< xtimer callback, arg: callback address */
+    TRACE_ISR_ENTER,        /**< interrupt entry, arg: interrupt number */
+    TRACE_ISR_EXIT,         /**< interrupt exit, arg: interrupt number */
+    TRACE_USER,             /**< application defined event */
+} trace_type_t;
+
+/**
+ * @brief   A recorded event
+ */
+typedef struct {
+    uint32_t time;          /**< xtimer timestamp */
+    uint32_t arg;           /**< type specific argument */
+    kernel_pid_t pid;       /**< thread active when the event was recorded */
+    uint8_t type;           /**< event type, see trace_type_t */
+} trace_event_t;
+
+/**
+ * @brief   Starts recording events
+ */
+void trace_start(void);
+
+/**
+ * @brief   Stops recording events
+ */
+void trace_stop(void);
+
+/**
+ * @brief   Discards all recorded events
+ */
+void trace_clear(void);
+
+/**
+ * @brief   Records an event
+ *
+ * Does nothing if recording is stopped. Can be called from interrupt
+ * context.
+ *
+ * @param[in] type  event type
+ * @param[in] arg   type specific argument
+ */
+void trace_event(trace_type_t type, uint32_t arg);
+
+/**
+ * @brief   Copies the recorded events, oldest first
+ *
+ * @param[out] events   buffer for the events
+ * @param[in] numof     number of events fitting into @p events
+ *
+ * @return  number of events copied
+ */
+unsigned trace_read(trace_event_t *events, unsigned numof);
+
+/**
+ * @brief   Returns the number of events recorded since the last
+ *          trace_clear(), including overwritten ones
+ */
+uint32_t trace_total(void);
+
+/**
+ * @brief   Prints the thread names and the recorded events
+ *
+ * Recording is paused while printing. The output is parsed by
+ * `dist/tools/trace/trace2chrome.py`.
+ */
+void trace_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H */
+/** @} */
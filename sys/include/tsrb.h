@@ -44,6 +44,14 @@ typedef struct tsrb {
     volatile unsigned writes;   /**< total number of writes */
 } tsrb_t;
 
+/**
+ * @brief     contiguous region of a tsrb's buffer
+ */
+typedef struct {
+    char *buf;                  /**< start of the region */
+    unsigned len;               /**< number of bytes in the region */
+} tsrb_span_t;
+
 /**
  * @brief Static initializer
  */
@@ -146,6 +154,58 @@ int tsrb_add_one(tsrb_t *rb, char c);
  */
 int tsrb_add(tsrb_t *rb, const char *src, size_t n);
 
+/**
+ * @brief       Get the bytes available for reading without copying them
+ *
+ * As the data may wrap around the end of the buffer, it is returned as up to
+ * two regions, @p span[0] holding the older bytes. Unused regions have a
+ * length of 0. Call tsrb_drop() when done with the data.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  span    the two regions
+ * @return      nr of bytes available for reading
+ */
+unsigned tsrb_peek_span(const tsrb_t *rb, tsrb_span_t span[2]);
+
+/**
+ * @brief       Remove bytes from the ringbuffer without reading them
+ *
+ * Must only be called by the consumer.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   max number of bytes to remove
+ * @return      nr of bytes removed
+ */
+unsigned tsrb_drop(tsrb_t *rb, unsigned n);
+
+/**
+ * @brief       Get the free space of the ringbuffer to write into directly
+ *
+ * The free space is returned as up to two regions, @p span[0] has to be
+ * filled first. Unused regions have a length of 0. The data only becomes
+ * visible to the consumer with tsrb_commit().
+ *
+ * Must only be called by the producer.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  span    the two regions
+ * @return      nr of bytes that can be written
+ */
+unsigned tsrb_write_span(const tsrb_t *rb, tsrb_span_t span[2]);
+
+/**
+ * @brief       Add bytes written into the regions returned by
+ *              tsrb_write_span() to the ringbuffer
+ *
+ * Must only be called by the producer.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   number of bytes written, must not exceed tsrb_free()
+ */
+void tsrb_commit(tsrb_t *rb, unsigned n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,13 @@
  * @ingroup     sys
  * @brief       universal address container
  *
+ * By default containers are looked up by a linear search over all
+ * `UNIVERSAL_ADDRESS_MAX_ENTRIES` entries. With the
+ * `universal_address_hash` module an open addressing hash index is kept over
+ * the containers and unused containers are tracked on a stack, so adding and
+ * finding an address takes constant time on average. The use count semantics
+ * are the same for both variants.
+ *
  * @{
  *
  * @file
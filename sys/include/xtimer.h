@@ -20,6 +20,11 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the `xtimer_wheel` module, timers are kept in a hierarchical timing
+ * wheel instead. Setting and removing a timer then takes constant time, while
+ * the timer ISR moves timers to finer wheel levels as their target approaches.
+ * Use it when many timers are active at the same time.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -62,6 +67,10 @@ typedef struct xtimer {
     timer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                  /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer *prev;        /**< reference to previous timer in timer
+                                     wheel slot (tail for the first timer) */
+#endif
 } xtimer_t;
 
 /**
@@ -235,6 +244,41 @@ void xtimer_set_wakeup(xtimer_t *timer, uint32_t offset, kernel_pid_t pid);
  */
 void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
 
+/**
+ * @brief Set a timer that wakes up a thread at an absolute time
+ *
+ * Unlike with relative offsets, the caller does not need to read the time
+ * itself, so the wakeup happens at @p target regardless of how long it took
+ * to get here.
+ *
+ * If @p target is closer than twice XTIMER_BACKOFF, this function spins until
+ * it passed and does not set the timer. The wakeup would reach the calling
+ * thread before it goes to sleep otherwise.
+ *
+ * @param[in] timer         timer struct to work with.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use
+ * @param[in] target        absolute time in microseconds, as returned by
+ *                          xtimer_now64()
+ * @param[in] pid           pid of the thread that will be woken up
+ *
+ * @return  0, if the timer was set
+ * @return  1, if @p target passed already and the timer was not set
+ */
+int xtimer_set_wakeup_absolute64(xtimer_t *timer, uint64_t target,
+                                 kernel_pid_t pid);
+
+/**
+ * @brief Stop execution of a thread until an absolute time
+ *
+ * Returns immediately if @p target passed already. When called from an ISR,
+ * this function will spin.
+ *
+ * @param[in] target        absolute time in microseconds, as returned by
+ *                          xtimer_now64()
+ */
+void xtimer_sleep_until64(uint64_t target);
+
 /**
  * @brief Set a timer to execute a callback at some time in the future
  *
@@ -255,6 +299,27 @@ void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
  */
 void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer to execute a callback at an absolute time
+ *
+ * Expects timer->callback to be set.
+ *
+ * If @p target is closer than twice XTIMER_BACKOFF, this function spins until
+ * it passed and neither sets the timer nor executes the callback.
+ *
+ * @warning The callback is executed in interrupt context, see xtimer_set().
+ *
+ * @param[in] timer         the timer structure to use.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use
+ * @param[in] target        absolute time in microseconds, as returned by
+ *                          xtimer_now64()
+ *
+ * @return  0, if the timer was set
+ * @return  1, if @p target passed already and the timer was not set
+ */
+int xtimer_set_absolute64(xtimer_t *timer, uint64_t target);
+
 /**
  * @brief remove a timer
  *
@@ -333,6 +398,18 @@ int xtimer_msg_receive_timeout64(msg_t *msg, uint64_t us);
 #define XTIMER_ISR_BACKOFF 20
 #endif
 
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   number of levels of the timer wheel
+ *
+ * Only used with the `xtimer_wheel` module. Every level has 16 slots, so the
+ * wheel covers timers up to 2^(4 * XTIMER_WHEEL_LEVELS) microseconds ahead.
+ * Timers further in the future are kept in a separate list that is only
+ * looked at when the wheel's time crosses that span.
+ */
+#define XTIMER_WHEEL_LEVELS (8U)
+#endif
+
 #ifndef XTIMER_SHIFT
 /**
  * @brief   xtimer prescaler value
@@ -14,12 +14,119 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+static inline uint32_t _fold(uint64_t sum)
+{
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return sum;
+}
+
+/**
+ * @brief   Sums up @p num 32-bit words in host byte order
+ *
+ * @pre @p buf is 32-bit aligned
+ */
+static uint64_t _sum_words(const uint8_t *buf, size_t num)
+{
+    uint64_t sum = 0;
+
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vsum = zero;
+    uint64_t part[4];
+
+    for (; num >= 8; buf += 32, num -= 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)buf);
+        vsum = _mm256_add_epi64(vsum, _mm256_unpacklo_epi32(v, zero));
+        vsum = _mm256_add_epi64(vsum, _mm256_unpackhi_epi32(v, zero));
+    }
+    _mm256_storeu_si256((__m256i *)part, vsum);
+    sum = part[0] + part[1] + part[2] + part[3];
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i vsum = zero;
+    uint64_t part[2];
+
+    for (; num >= 4; buf += 16, num -= 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)buf);
+        vsum = _mm_add_epi64(vsum, _mm_unpacklo_epi32(v, zero));
+        vsum = _mm_add_epi64(vsum, _mm_unpackhi_epi32(v, zero));
+    }
+    _mm_storeu_si128((__m128i *)part, vsum);
+    sum = part[0] + part[1];
+#endif
+
+    for (; num >= 4; buf += 16, num -= 4) {
+        uint32_t w[4];
+
+        memcpy(w, buf, sizeof(w));
+        sum += (uint64_t)w[0] + w[1] + w[2] + w[3];
+    }
+    for (; num > 0; buf += 4, num--) {
+        uint32_t w;
+
+        memcpy(&w, buf, sizeof(w));
+        sum += w;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief   Sums up @p buf as big-endian 16-bit words, a trailing odd byte
+ *          being the top half of the last word
+ *
+ * @return  the sum folded to 16 bit
+ */
+static uint16_t _sum(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+    /* on an odd address the sum is taken over buf shifted by one byte
+     * which yields the byte swapped sum */
+    int shifted = (len > 0) && ((uintptr_t)buf & 1);
+
+    if (shifted) {
+        sum += *buf;            /* bottom half of the first (shifted) word */
+        buf++;
+        len--;
+    }
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        sum += (uint16_t)(buf[0] << 8) + buf[1];
+        buf += 2;
+        len -= 2;
+    }
+
+    /* one's complement addition is byte order independent, so the bulk is
+     * summed in host byte order and converted afterwards */
+    sum += NTOHS(_fold(_sum_words(buf, len >> 2)));
+    buf += len & ~((size_t)3);
+    len &= 3;
+
+    if (len >= 2) {
+        sum += (uint16_t)(buf[0] << 8) + buf[1];
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        sum += (uint16_t)(*buf << 8);
+    }
+
+    sum = _fold(sum);
+    return (shifted) ? byteorder_swaps(sum) : sum;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -44,18 +151,9 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
-    }
-
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
-    }
+    /* group bytes by 16-byte words and add them, if the remaining length is
+     * odd the last byte is added as top half of a 16-byte word */
+    csum = _fold(csum + _sum(buf, len));
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
@@ -408,6 +408,7 @@ int gnrc_tftp_server(tftp_data_cb_t data_cb, tftp_start_cb_t start_cb, tftp_stop
     ctxt.start_cb = start_cb;
     ctxt.stop_cb = stop_cb;
     ctxt.enable_options = use_options;
+    ctxt.timer.target = ctxt.timer.long_target = 0;
 
     /* validate our arguments */
     assert(data_cb);
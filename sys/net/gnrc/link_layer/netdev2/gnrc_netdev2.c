@@ -22,6 +22,7 @@
 
 #include "msg.h"
 #include "thread.h"
+#include "thread_flags.h"
 
 #include "net/gnrc.h"
 #include "net/gnrc/nettype.h"
@@ -39,6 +40,11 @@
 
 #define NETDEV2_NETAPI_MSG_QUEUE_SIZE 8
 
+/**
+ * @brief   Thread flag signaling a pending device interrupt
+ */
+#define NETDEV2_FLAG_ISR    (0x1 << 0)
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt);
 
 /**
@@ -53,14 +59,10 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event, void *data)
     gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t*) dev->isr_arg;
 
     if (event == NETDEV2_EVENT_ISR) {
-        msg_t msg;
-
-        msg.type = NETDEV2_MSG_TYPE_EVENT;
-        msg.content.ptr = (void*) gnrc_netdev2;
-
-        if (msg_send(&msg, gnrc_netdev2->pid) <= 0) {
-            puts("gnrc_netdev2: possibly lost interrupt.");
-        }
+        /* interrupts firing before the thread got to handle the first one
+         * are coalesced into one flag, so none of them can get lost */
+        thread_flags_set((thread_t *)sched_threads[gnrc_netdev2->pid],
+                         NETDEV2_FLAG_ISR);
     }
     else {
         DEBUG("gnrc_netdev2: event triggered -> %i\n", event);
@@ -99,6 +101,61 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+/**
+ * @brief   Handles a NETAPI message sent to the gnrc_netdev2 thread
+ *
+ * @param[in] gnrc_netdev2  the adapter state
+ * @param[in] msg           the message
+ */
+static void _handle_msg(gnrc_netdev2_t *gnrc_netdev2, msg_t *msg)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    gnrc_netapi_opt_t *opt;
+    msg_t reply;
+    int res;
+
+    switch (msg->type) {
+        case NETDEV2_MSG_TYPE_EVENT:
+            DEBUG("gnrc_netdev2: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
+            dev->driver->isr(dev);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
+            gnrc_pktsnip_t *pkt = (gnrc_pktsnip_t *)msg->content.ptr;
+            gnrc_netdev2->send(gnrc_netdev2, pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SET:
+            /* read incoming options */
+            opt = (gnrc_netapi_opt_t *)msg->content.ptr;
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SET received. opt=%s\n",
+                    netopt2str(opt->opt));
+            /* set option for device driver */
+            res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("gnrc_netdev2: response of netdev->set: %i\n", res);
+            /* send reply to calling thread */
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = (uint32_t)res;
+            msg_reply(msg, &reply);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_GET:
+            /* read incoming options */
+            opt = (gnrc_netapi_opt_t *)msg->content.ptr;
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_GET received. opt=%s\n",
+                    netopt2str(opt->opt));
+            /* get option from device driver */
+            res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("gnrc_netdev2: response of netdev->get: %i\n", res);
+            /* send reply to calling thread */
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = (uint32_t)res;
+            msg_reply(msg, &reply);
+            break;
+        default:
+            DEBUG("gnrc_netdev2: Unknown command %" PRIu16 "\n", msg->type);
+            break;
+    }
+}
+
 /**
  * @brief   Startup code and event loop of the gnrc_netdev2 layer
  *
@@ -115,9 +172,7 @@ static void *_gnrc_netdev2_thread(void *args)
 
     gnrc_netdev2->pid = thread_getpid();
 
-    gnrc_netapi_opt_t *opt;
-    int res;
-    msg_t msg, reply, msg_queue[NETDEV2_NETAPI_MSG_QUEUE_SIZE];
+    msg_t msg, msg_queue[NETDEV2_NETAPI_MSG_QUEUE_SIZE];
 
     /* setup the MAC layers message queue */
     msg_init_queue(msg_queue, NETDEV2_NETAPI_MSG_QUEUE_SIZE);
@@ -134,48 +189,25 @@ static void *_gnrc_netdev2_thread(void *args)
 
     /* start the event loop */
     while (1) {
-        DEBUG("gnrc_netdev2: waiting for incoming messages\n");
-        msg_receive(&msg);
-        /* dispatch NETDEV and NETAPI messages */
-        switch (msg.type) {
-            case NETDEV2_MSG_TYPE_EVENT:
-                DEBUG("gnrc_netdev2: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
+        DEBUG("gnrc_netdev2: waiting for events\n");
+        thread_flags_t flags = thread_flags_wait_any(NETDEV2_FLAG_ISR |
+                                                     THREAD_FLAG_MSG_WAITING);
+
+        if (flags & NETDEV2_FLAG_ISR) {
+            /* the driver may trigger another interrupt while handling this
+             * one, so call it until the device has nothing more to report */
+            do {
+                DEBUG("gnrc_netdev2: handling device interrupt\n");
                 dev->driver->isr(dev);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                gnrc_pktsnip_t *pkt = (gnrc_pktsnip_t *)msg.content.ptr;
-                gnrc_netdev2->send(gnrc_netdev2, pkt);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SET:
-                /* read incoming options */
-                opt = (gnrc_netapi_opt_t *)msg.content.ptr;
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SET received. opt=%s\n",
-                        netopt2str(opt->opt));
-                /* set option for device driver */
-                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("gnrc_netdev2: response of netdev->set: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_GET:
-                /* read incoming options */
-                opt = (gnrc_netapi_opt_t *)msg.content.ptr;
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_GET received. opt=%s\n",
-                        netopt2str(opt->opt));
-                /* get option from device driver */
-                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("gnrc_netdev2: response of netdev->get: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            default:
-                DEBUG("gnrc_netdev2: Unknown command %" PRIu16 "\n", msg.type);
-                break;
+            } while (thread_flags_clear(NETDEV2_FLAG_ISR));
+        }
+        if (!(flags & THREAD_FLAG_MSG_WAITING)) {
+            continue;
+        }
+
+        /* dispatch all queued NETAPI messages */
+        while (msg_try_receive(&msg) == 1) {
+            _handle_msg(gnrc_netdev2, &msg);
         }
     }
     /* never reached */
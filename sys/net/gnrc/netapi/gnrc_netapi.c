@@ -22,6 +22,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netapi/direct.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -59,9 +62,18 @@ static inline int _get_set(kernel_pid_t pid, uint16_t type,
     return (int)ack.content.value;
 }
 
-static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, gnrc_pktsnip_t *pkt)
+static inline int _snd_rcv(kernel_pid_t pid, gnrc_nettype_t nettype,
+                           uint16_t type, gnrc_pktsnip_t *pkt)
 {
     msg_t msg;
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    if ((pid == gnrc_netapi_direct_pid) && (pid != KERNEL_PID_UNDEF)) {
+        /* layers sharing the stack thread get their packets without a message */
+        return gnrc_netapi_direct_put(nettype, type, pkt);
+    }
+#else
+    (void)nettype;
+#endif
     /* set the outgoing message's fields */
     msg.type = type;
     msg.content.ptr = (void *)pkt;
@@ -85,7 +97,7 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
-            if (_snd_rcv(sendto->pid, cmd, pkt) < 1) {
+            if (_snd_rcv(sendto->pid, type, cmd, pkt) < 1) {
                 /* unable to dispatch packet */
                 gnrc_pktbuf_release(pkt);
             }
@@ -98,12 +110,12 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
 
 int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
 {
-    return _snd_rcv(pid, GNRC_NETAPI_MSG_TYPE_SND, pkt);
+    return _snd_rcv(pid, GNRC_NETTYPE_UNDEF, GNRC_NETAPI_MSG_TYPE_SND, pkt);
 }
 
 int gnrc_netapi_receive(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
 {
-    return _snd_rcv(pid, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
+    return _snd_rcv(pid, GNRC_NETTYPE_UNDEF, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
 int gnrc_netapi_get(kernel_pid_t pid, netopt_t opt, uint16_t context,
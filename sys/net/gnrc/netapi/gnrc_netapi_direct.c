@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_netapi_direct
+ * @file
+ * @brief       Shared stack thread running the GNRC layers run-to-completion
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "cib.h"
+#include "irq.h"
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netapi/direct.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   A layer sharing the stack thread
+ */
+typedef struct {
+    gnrc_netreg_entry_t netreg;             /**< registration in netreg */
+    gnrc_netapi_direct_handler_t handler;   /**< the layer's message handler */
+    gnrc_nettype_t type;                    /**< packet type of the layer */
+} _layer_t;
+
+/**
+ * @brief   A packet waiting in the event queue
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;                    /**< the packet */
+    gnrc_nettype_t type;                    /**< type of the target layer */
+    uint16_t cmd;                           /**< RCV or SND */
+} _event_t;
+
+kernel_pid_t gnrc_netapi_direct_pid = KERNEL_PID_UNDEF;
+
+#if ENABLE_DEBUG
+static char _stack[GNRC_NETAPI_DIRECT_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
+#else
+static char _stack[GNRC_NETAPI_DIRECT_STACK_SIZE];
+#endif
+
+static _layer_t _layers[GNRC_NETAPI_DIRECT_LAYER_NUMOF];
+static unsigned _layers_numof;
+
+static _event_t _events[GNRC_NETAPI_DIRECT_EVENT_QUEUE_SIZE];
+static cib_t _events_cib = CIB_INIT(GNRC_NETAPI_DIRECT_EVENT_QUEUE_SIZE);
+
+static void *_event_loop(void *args);
+
+kernel_pid_t gnrc_netapi_direct_register(gnrc_nettype_t type,
+                                         gnrc_netapi_direct_handler_t handler)
+{
+    _layer_t *layer;
+
+    if (_layers_numof >= GNRC_NETAPI_DIRECT_LAYER_NUMOF) {
+        DEBUG("gnrc_netapi_direct: no space left for layer %d\n", (int)type);
+        return KERNEL_PID_UNDEF;
+    }
+    if (gnrc_netapi_direct_pid == KERNEL_PID_UNDEF) {
+        gnrc_netapi_direct_pid = thread_create(_stack, sizeof(_stack),
+                                               GNRC_NETAPI_DIRECT_PRIO,
+                                               THREAD_CREATE_STACKTEST,
+                                               _event_loop, NULL, "gnrc");
+    }
+
+    layer = &_layers[_layers_numof++];
+    layer->handler = handler;
+    layer->type = type;
+    layer->netreg.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    layer->netreg.pid = gnrc_netapi_direct_pid;
+    gnrc_netreg_register(type, &layer->netreg);
+
+    return gnrc_netapi_direct_pid;
+}
+
+static gnrc_nettype_t _layer_type(uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    /* packets sent down the stack may have a netif header in front */
+    if ((cmd == GNRC_NETAPI_MSG_TYPE_SND) && (pkt->type == GNRC_NETTYPE_NETIF) &&
+        (pkt->next != NULL)) {
+        return pkt->next->type;
+    }
+    return pkt->type;
+}
+
+static int _handle(gnrc_nettype_t type, uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    if (type == GNRC_NETTYPE_UNDEF) {
+        type = _layer_type(cmd, pkt);
+    }
+    for (unsigned i = 0; i < _layers_numof; i++) {
+        if (_layers[i].type == type) {
+            msg_t msg;
+
+            msg.sender_pid = gnrc_netapi_direct_pid;
+            msg.type = cmd;
+            msg.content.ptr = (void *)pkt;
+            _layers[i].handler(&msg);
+            return 1;
+        }
+    }
+    DEBUG("gnrc_netapi_direct: no layer for type %d\n", (int)type);
+    return -1;
+}
+
+int gnrc_netapi_direct_put(gnrc_nettype_t type, uint16_t cmd,
+                           gnrc_pktsnip_t *pkt)
+{
+    unsigned state;
+    int idx;
+    bool empty;
+
+    state = irq_disable();
+    empty = (cib_avail(&_events_cib) == 0);
+    idx = cib_put(&_events_cib);
+    if (idx < 0) {
+        irq_restore(state);
+        DEBUG("gnrc_netapi_direct: event queue is full\n");
+        return 0;
+    }
+    _events[idx].pkt = pkt;
+    _events[idx].type = type;
+    _events[idx].cmd = cmd;
+    irq_restore(state);
+
+    /* The stack thread drains the event queue after every message it
+     * receives, so the next layer runs as soon as the current one returns.
+     * Other threads only need to wake it up if the queue was empty. If that
+     * fails, its message queue is full and the event will be handled after
+     * one of the pending messages. */
+    if (empty && ((thread_getpid() != gnrc_netapi_direct_pid) || irq_is_in())) {
+        msg_t msg;
+
+        msg.type = GNRC_NETAPI_DIRECT_MSG_TYPE_EVENT;
+        msg.content.ptr = NULL;
+        msg_try_send(&msg, gnrc_netapi_direct_pid);
+    }
+    return 1;
+}
+
+static void _drain(void)
+{
+    while (1) {
+        unsigned state = irq_disable();
+        int idx = cib_get(&_events_cib);
+        _event_t event;
+
+        if (idx < 0) {
+            irq_restore(state);
+            return;
+        }
+        event = _events[idx];
+        irq_restore(state);
+
+        if (_handle(event.type, event.cmd, event.pkt) < 1) {
+            gnrc_pktbuf_release(event.pkt);
+        }
+    }
+}
+
+static void *_event_loop(void *args)
+{
+    msg_t msg, reply, msg_q[GNRC_NETAPI_DIRECT_MSG_QUEUE_SIZE];
+
+    (void)args;
+    msg_init_queue(msg_q, GNRC_NETAPI_DIRECT_MSG_QUEUE_SIZE);
+
+    /* preinitialize ACK */
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)-ENOTSUP;
+
+    /* start event loop */
+    while (1) {
+        DEBUG("gnrc_netapi_direct: waiting for incoming message.\n");
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_NETAPI_DIRECT_MSG_TYPE_EVENT:
+                /* handled below */
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                /* sent to the stack's PID without netapi */
+                if (_handle(GNRC_NETTYPE_UNDEF, msg.type,
+                            (gnrc_pktsnip_t *)msg.content.ptr) < 1) {
+                    gnrc_pktbuf_release((gnrc_pktsnip_t *)msg.content.ptr);
+                }
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                /* none of the sharing layers supports options */
+                DEBUG("gnrc_netapi_direct: reply to unsupported get/set\n");
+                msg_reply(&msg, &reply);
+                break;
+
+            default: {
+                unsigned i;
+
+                for (i = 0; i < _layers_numof; i++) {
+                    if (_layers[i].handler(&msg)) {
+                        break;
+                    }
+                }
+                if (i == _layers_numof) {
+                    DEBUG("gnrc_netapi_direct: operation not supported\n");
+                }
+                break;
+            }
+        }
+
+        _drain();
+    }
+
+    /* never reached */
+    return NULL;
+}
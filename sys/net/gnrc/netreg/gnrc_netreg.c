@@ -27,13 +27,35 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+/* The registry as lookup table by gnrc_nettype_t of hash tables by demux
+ * context. Entries with the same demux context are kept next to each other
+ * in their bucket */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_HASH_BUCKETS];
+
+/* returns the link pointing to the first entry with demux_ctx or to the end
+ * of the bucket, if there is none */
+static gnrc_netreg_entry_t **_find(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    uint32_t hash = demux_ctx ^ (demux_ctx >> 16);
+    gnrc_netreg_entry_t **link;
+
+    hash ^= (hash >> 8);
+    link = &netreg[type][hash & (GNRC_NETREG_HASH_BUCKETS - 1)];
+    while ((*link != NULL) && ((*link)->demux_ctx != demux_ctx)) {
+        link = &(*link)->next;
+    }
+    return link;
+}
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#endif
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -45,7 +67,15 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    /* prepend to the entries with the same demux context */
+    gnrc_netreg_entry_t **link = _find(type, entry->demux_ctx);
+
+    entry->next = *link;
+    *link = entry;
+#else
     LL_PREPEND(netreg[type], entry);
+#endif
 
     return 0;
 }
@@ -56,7 +86,19 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    gnrc_netreg_entry_t **link = _find(type, entry->demux_ctx);
+
+    while ((*link != NULL) && ((*link)->demux_ctx == entry->demux_ctx)) {
+        if (*link == entry) {
+            *link = entry->next;
+            return;
+        }
+        link = &(*link)->next;
+    }
+#else
     LL_DELETE(netreg[type], entry);
+#endif
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -67,7 +109,11 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    res = *_find(type, demux_ctx);
+#else
     LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+#endif
 
     return res;
 }
@@ -81,6 +127,13 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
         return 0;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    /* only walks the entries with demux_ctx */
+    for (entry = *_find(type, demux_ctx); entry != NULL;
+         entry = gnrc_netreg_getnext(entry)) {
+        num++;
+    }
+#else
     entry = netreg[type];
 
     while (entry != NULL) {
@@ -90,6 +143,7 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 
         entry = entry->next;
     }
+#endif
 
     return num;
 }
@@ -104,7 +158,13 @@ gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 
     demux_ctx = entry->demux_ctx;
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    /* entries with the same demux context are adjacent */
+    entry = ((entry->next != NULL) && (entry->next->demux_ctx == demux_ctx)) ?
+            entry->next : NULL;
+#else
     LL_SEARCH_SCALAR(entry->next, entry, demux_ctx, demux_ctx);
+#endif
 
     return entry;
 }
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ *
+ * @author      agent <agent@local>
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dc.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+static gnrc_ipv6_dc_t _dcache[GNRC_IPV6_DC_SIZE];
+/* entries by hash of their interface and destination */
+static gnrc_ipv6_dc_t *_buckets[GNRC_IPV6_DC_HASH_BUCKETS];
+/* next entry to be replaced */
+static unsigned _next;
+/* only entries of the current generation are valid. Starts at 1 so that
+ * zero-initialized entries never are */
+static volatile uint32_t _generation = 1;
+/* generation at the last lookup, i.e. before next hop determination */
+static uint32_t _get_generation;
+#ifdef MODULE_FIB
+static uint32_t _fib_generation;
+#endif
+
+static inline gnrc_ipv6_dc_t **_bucket(kernel_pid_t req_iface,
+                                       const ipv6_addr_t *dst)
+{
+    uint32_t hash = dst->u32[0].u32 ^ dst->u32[1].u32 ^
+                    dst->u32[2].u32 ^ dst->u32[3].u32 ^ (uint32_t)req_iface;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return &_buckets[hash % GNRC_IPV6_DC_HASH_BUCKETS];
+}
+
+static gnrc_ipv6_dc_t *_lookup(kernel_pid_t req_iface, const ipv6_addr_t *dst)
+{
+    for (gnrc_ipv6_dc_t *entry = *_bucket(req_iface, dst); entry != NULL;
+         entry = entry->next) {
+        if ((entry->req_iface == req_iface) &&
+            ipv6_addr_equal(&(entry->dst), dst)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void _unindex(gnrc_ipv6_dc_t *entry)
+{
+    gnrc_ipv6_dc_t **bucket = _bucket(entry->req_iface, &(entry->dst));
+
+    while (*bucket != entry) {
+        bucket = &(*bucket)->next;
+    }
+    *bucket = entry->next;
+}
+
+void gnrc_ipv6_dc_init(void)
+{
+    memset(_dcache, 0, sizeof(_dcache));
+    memset(_buckets, 0, sizeof(_buckets));
+    _next = 0;
+    _generation++;
+}
+
+gnrc_ipv6_dc_t *gnrc_ipv6_dc_add(kernel_pid_t req_iface, const ipv6_addr_t *dst,
+                                 const ipv6_addr_t *src, kernel_pid_t iface,
+                                 const uint8_t *l2_addr, uint8_t l2_addr_len)
+{
+    gnrc_ipv6_dc_t *entry = _lookup(req_iface, dst);
+
+    assert(l2_addr_len <= GNRC_IPV6_NC_L2_ADDR_MAX);
+
+    if (entry == NULL) {
+        gnrc_ipv6_dc_t **bucket;
+
+        entry = &_dcache[_next];
+        _next = (_next + 1) % GNRC_IPV6_DC_SIZE;
+        /* entries are only ever added with an interface */
+        if (entry->iface != KERNEL_PID_UNDEF) {
+            _unindex(entry);
+        }
+        entry->req_iface = req_iface;
+        memcpy(&(entry->dst), dst, sizeof(ipv6_addr_t));
+        bucket = _bucket(req_iface, dst);
+        entry->next = *bucket;
+        *bucket = entry;
+    }
+
+    if (src != NULL) {
+        memcpy(&(entry->src), src, sizeof(ipv6_addr_t));
+    }
+    else {
+        ipv6_addr_set_unspecified(&(entry->src));
+    }
+    entry->iface = iface;
+    memcpy(entry->l2_addr, l2_addr, l2_addr_len);
+    entry->l2_addr_len = l2_addr_len;
+    /* invalidations during next hop determination must not be lost */
+    entry->generation = _get_generation;
+    entry->expires = xtimer_now() + GNRC_IPV6_DC_LIFETIME;
+
+    DEBUG("ipv6_dc: cached %s => %" PRIkernel_pid "\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), iface);
+
+    return entry;
+}
+
+gnrc_ipv6_dc_t *gnrc_ipv6_dc_get(kernel_pid_t req_iface, const ipv6_addr_t *dst)
+{
+    gnrc_ipv6_dc_t *entry;
+
+#ifdef MODULE_FIB
+    if (gnrc_ipv6_fib_table.generation != _fib_generation) {
+        _fib_generation = gnrc_ipv6_fib_table.generation;
+        _generation++;
+    }
+#endif
+    _get_generation = _generation;
+    entry = _lookup(req_iface, dst);
+    if ((entry == NULL) || (entry->generation != _get_generation) ||
+        ((int32_t)(entry->expires - xtimer_now()) <= 0)) {
+        return NULL;
+    }
+    return entry;
+}
+
+void gnrc_ipv6_dc_invalidate(void)
+{
+    _generation++;
+}
+
+/** @} */
@@ -35,17 +35,22 @@
 #include "net/gnrc/ipv6/blacklist.h"
 
 #include "net/gnrc/ipv6.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netapi/direct.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 #define _MAX_L2_ADDR_LEN    (8U)
 
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 #if ENABLE_DEBUG
 static char _stack[GNRC_IPV6_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_IPV6_STACK_SIZE];
 #endif
+#endif
 
 #ifdef MODULE_FIB
 #include "net/fib.h"
@@ -54,6 +59,9 @@ static char _stack[GNRC_IPV6_STACK_SIZE];
  * @brief buffer to store the entries in the IPv6 forwarding table
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
+#ifdef MODULE_FIB_TRIE
+static fib_trie_node_t _fib_trie_nodes[FIB_TRIE_NODES_NUMOF(GNRC_IPV6_FIB_TABLE_SIZE)];
+#endif
 
 /**
  * @brief the IPv6 forwarding table
@@ -73,8 +81,12 @@ static void _receive(gnrc_pktsnip_t *pkt);
  * prep_hdr: prepare header for sending (call to _fill_ipv6_hdr()), otherwise
  * assume it is already prepared */
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr);
+/* Handles a message for IPv6, returns false for unknown message types */
+static bool _handle_msg(msg_t *msg);
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 /* Main event loop for IPv6 */
 static void *_event_loop(void *args);
+#endif
 
 /* Handles encapsulated IPv6 packets: http://tools.ietf.org/html/rfc2473 */
 static void _decapsulate(gnrc_pktsnip_t *pkt);
@@ -82,15 +94,23 @@ static void _decapsulate(gnrc_pktsnip_t *pkt);
 kernel_pid_t gnrc_ipv6_init(void)
 {
     if (gnrc_ipv6_pid == KERNEL_PID_UNDEF) {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+        gnrc_ipv6_pid = gnrc_netapi_direct_register(GNRC_NETTYPE_IPV6,
+                                                    _handle_msg);
+#else
         gnrc_ipv6_pid = thread_create(_stack, sizeof(_stack), GNRC_IPV6_PRIO,
                                       THREAD_CREATE_STACKTEST,
                                       _event_loop, NULL, "ipv6");
+#endif
     }
 
 #ifdef MODULE_FIB
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
+#ifdef MODULE_FIB_TRIE
+    gnrc_ipv6_fib_table.trie_nodes = _fib_trie_nodes;
+#endif
     fib_init(&gnrc_ipv6_fib_table);
 #endif
 
@@ -238,129 +258,138 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
     }
 }
 
-static void *_event_loop(void *args)
+static bool _handle_msg(msg_t *msg)
 {
-    msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t me_reg;
-
-    (void)args;
-    msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
-
-    me_reg.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
-    me_reg.pid = thread_getpid();
+    msg_t reply;
 
-    /* register interest in all IPv6 packets */
-    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
-
-    /* preinitialize ACK */
-    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+            _receive((gnrc_pktsnip_t *)msg->content.ptr);
+            break;
 
-    /* start event loop */
-    while (1) {
-        DEBUG("ipv6: waiting for incoming message.\n");
-        msg_receive(&msg);
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
+            _send((gnrc_pktsnip_t *)msg->content.ptr, true);
+            break;
 
-        switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
-                _receive((gnrc_pktsnip_t *)msg.content.ptr);
-                break;
+        case GNRC_NETAPI_MSG_TYPE_GET:
+        case GNRC_NETAPI_MSG_TYPE_SET:
+            DEBUG("ipv6: reply to unsupported get/set\n");
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = -ENOTSUP;
+            msg_reply(msg, &reply);
+            break;
 
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                _send((gnrc_pktsnip_t *)msg.content.ptr, true);
-                break;
+#ifdef MODULE_GNRC_NDP
+        case GNRC_NDP_MSG_RTR_TIMEOUT:
+            DEBUG("ipv6: Router timeout received\n");
+            ((gnrc_ipv6_nc_t *)msg->content.ptr)->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+            gnrc_ipv6_dc_invalidate();
+            break;
 
-            case GNRC_NETAPI_MSG_TYPE_GET:
-            case GNRC_NETAPI_MSG_TYPE_SET:
-                DEBUG("ipv6: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
+        /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
+         * solved properly */
+        /* case GNRC_NDP_MSG_ADDR_TIMEOUT: */
+        /*     DEBUG("ipv6: Router advertisement timer event received\n"); */
+        /*     gnrc_ipv6_netif_remove_addr(KERNEL_PID_UNDEF, */
+        /*                                 (ipv6_addr_t *)msg->content.ptr); */
+        /*     break; */
+
+        case GNRC_NDP_MSG_NBR_SOL_RETRANS:
+            DEBUG("ipv6: Neigbor solicitation retransmission timer event received\n");
+            gnrc_ndp_retrans_nbr_sol((gnrc_ipv6_nc_t *)msg->content.ptr);
+            break;
 
-#ifdef MODULE_GNRC_NDP
-            case GNRC_NDP_MSG_RTR_TIMEOUT:
-                DEBUG("ipv6: Router timeout received\n");
-                ((gnrc_ipv6_nc_t *)msg.content.ptr)->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
-                break;
-
-            /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
-             * solved properly */
-            /* case GNRC_NDP_MSG_ADDR_TIMEOUT: */
-            /*     DEBUG("ipv6: Router advertisement timer event received\n"); */
-            /*     gnrc_ipv6_netif_remove_addr(KERNEL_PID_UNDEF, */
-            /*                                 (ipv6_addr_t *)msg.content.ptr); */
-            /*     break; */
-
-            case GNRC_NDP_MSG_NBR_SOL_RETRANS:
-                DEBUG("ipv6: Neigbor solicitation retransmission timer event received\n");
-                gnrc_ndp_retrans_nbr_sol((gnrc_ipv6_nc_t *)msg.content.ptr);
-                break;
-
-            case GNRC_NDP_MSG_NC_STATE_TIMEOUT:
-                DEBUG("ipv6: Neigbor cache state timeout received\n");
-                gnrc_ndp_state_timeout((gnrc_ipv6_nc_t *)msg.content.ptr);
-                break;
+        case GNRC_NDP_MSG_NC_STATE_TIMEOUT:
+            DEBUG("ipv6: Neigbor cache state timeout received\n");
+            gnrc_ndp_state_timeout((gnrc_ipv6_nc_t *)msg->content.ptr);
+            break;
 #endif
 #ifdef MODULE_GNRC_NDP_ROUTER
-            case GNRC_NDP_MSG_RTR_ADV_RETRANS:
-                DEBUG("ipv6: Router advertisement retransmission event received\n");
-                gnrc_ndp_router_retrans_rtr_adv((gnrc_ipv6_netif_t *)msg.content.ptr);
-                break;
-            case GNRC_NDP_MSG_RTR_ADV_DELAY:
-                DEBUG("ipv6: Delayed router advertisement event received\n");
-                gnrc_ndp_router_send_rtr_adv((gnrc_ipv6_nc_t *)msg.content.ptr);
-                break;
+        case GNRC_NDP_MSG_RTR_ADV_RETRANS:
+            DEBUG("ipv6: Router advertisement retransmission event received\n");
+            gnrc_ndp_router_retrans_rtr_adv((gnrc_ipv6_netif_t *)msg->content.ptr);
+            break;
+        case GNRC_NDP_MSG_RTR_ADV_DELAY:
+            DEBUG("ipv6: Delayed router advertisement event received\n");
+            gnrc_ndp_router_send_rtr_adv((gnrc_ipv6_nc_t *)msg->content.ptr);
+            break;
 #endif
 #ifdef MODULE_GNRC_NDP_HOST
-            case GNRC_NDP_MSG_RTR_SOL_RETRANS:
-                DEBUG("ipv6: Router solicitation retransmission event received\n");
-                gnrc_ndp_host_retrans_rtr_sol((gnrc_ipv6_netif_t *)msg.content.ptr);
-                break;
+        case GNRC_NDP_MSG_RTR_SOL_RETRANS:
+            DEBUG("ipv6: Router solicitation retransmission event received\n");
+            gnrc_ndp_host_retrans_rtr_sol((gnrc_ipv6_netif_t *)msg->content.ptr);
+            break;
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN_ND
-            case GNRC_SIXLOWPAN_ND_MSG_MC_RTR_SOL:
-                DEBUG("ipv6: Multicast router solicitation event received\n");
-                gnrc_sixlowpan_nd_mc_rtr_sol((gnrc_ipv6_netif_t *)msg.content.ptr);
-                break;
-            case GNRC_SIXLOWPAN_ND_MSG_UC_RTR_SOL:
-                DEBUG("ipv6: Unicast router solicitation event received\n");
-                gnrc_sixlowpan_nd_uc_rtr_sol((gnrc_ipv6_nc_t *)msg.content.ptr);
-                break;
+        case GNRC_SIXLOWPAN_ND_MSG_MC_RTR_SOL:
+            DEBUG("ipv6: Multicast router solicitation event received\n");
+            gnrc_sixlowpan_nd_mc_rtr_sol((gnrc_ipv6_netif_t *)msg->content.ptr);
+            break;
+        case GNRC_SIXLOWPAN_ND_MSG_UC_RTR_SOL:
+            DEBUG("ipv6: Unicast router solicitation event received\n");
+            gnrc_sixlowpan_nd_uc_rtr_sol((gnrc_ipv6_nc_t *)msg->content.ptr);
+            break;
 #   ifdef MODULE_GNRC_SIXLOWPAN_CTX
-            case GNRC_SIXLOWPAN_ND_MSG_DELETE_CTX:
-                DEBUG("ipv6: Delete 6LoWPAN context event received\n");
-                gnrc_sixlowpan_ctx_remove(((((gnrc_sixlowpan_ctx_t *)msg.content.ptr)->flags_id) &
-                                           GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK));
-                break;
+        case GNRC_SIXLOWPAN_ND_MSG_DELETE_CTX:
+            DEBUG("ipv6: Delete 6LoWPAN context event received\n");
+            gnrc_sixlowpan_ctx_remove(((((gnrc_sixlowpan_ctx_t *)msg->content.ptr)->flags_id) &
+                                       GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK));
+            break;
 #   endif
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
-            case GNRC_SIXLOWPAN_ND_MSG_ABR_TIMEOUT:
-                DEBUG("ipv6: border router timeout event received\n");
-                gnrc_sixlowpan_nd_router_abr_remove(
-                        (gnrc_sixlowpan_nd_router_abr_t *)msg.content.ptr);
-                break;
-            /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
-             * solved properly */
-            /* case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT: */
-            /*     DEBUG("ipv6: address registration timeout received\n"); */
-            /*     gnrc_sixlowpan_nd_router_gc_nc((gnrc_ipv6_nc_t *)msg.content.ptr); */
-            /*     break; */
-            case GNRC_NDP_MSG_RTR_ADV_SIXLOWPAN_DELAY:
-                DEBUG("ipv6: Delayed router advertisement event received\n");
-                gnrc_ipv6_nc_t *nc_entry = (gnrc_ipv6_nc_t *)msg.content.ptr;
-                gnrc_ndp_internal_send_rtr_adv(nc_entry->iface, NULL,
-                                               &(nc_entry->ipv6_addr), false);
-                break;
-#endif
-            default:
-                break;
-        }
+        case GNRC_SIXLOWPAN_ND_MSG_ABR_TIMEOUT:
+            DEBUG("ipv6: border router timeout event received\n");
+            gnrc_sixlowpan_nd_router_abr_remove(
+                    (gnrc_sixlowpan_nd_router_abr_t *)msg->content.ptr);
+            break;
+        /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
+         * solved properly */
+        /* case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT: */
+        /*     DEBUG("ipv6: address registration timeout received\n"); */
+        /*     gnrc_sixlowpan_nd_router_gc_nc((gnrc_ipv6_nc_t *)msg->content.ptr); */
+        /*     break; */
+        case GNRC_NDP_MSG_RTR_ADV_SIXLOWPAN_DELAY:
+            DEBUG("ipv6: Delayed router advertisement event received\n");
+            gnrc_ipv6_nc_t *nc_entry = (gnrc_ipv6_nc_t *)msg->content.ptr;
+            gnrc_ndp_internal_send_rtr_adv(nc_entry->iface, NULL,
+                                           &(nc_entry->ipv6_addr), false);
+            break;
+#endif
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+#ifndef MODULE_GNRC_NETAPI_DIRECT
+static void *_event_loop(void *args)
+{
+    msg_t msg, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+    gnrc_netreg_entry_t me_reg;
+
+    (void)args;
+    msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
+
+    me_reg.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    me_reg.pid = thread_getpid();
+
+    /* register interest in all IPv6 packets */
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
+
+    /* start event loop */
+    while (1) {
+        DEBUG("ipv6: waiting for incoming message.\n");
+        msg_receive(&msg);
+        _handle_msg(&msg);
     }
 
     return NULL;
 }
+#endif
 
 static void _send_to_iface(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 {
@@ -649,6 +678,9 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     gnrc_pktsnip_t *ipv6, *payload;
     ipv6_addr_t *tmp;
     ipv6_hdr_t *hdr;
+#ifdef MODULE_GNRC_IPV6_DC
+    gnrc_ipv6_dc_t *dc_entry;
+#endif
     /* get IPv6 snip and (if present) generic interface header */
     if (pkt->type == GNRC_NETTYPE_NETIF) {
         /* If there is already a netif header (routing protocols and
@@ -690,6 +722,28 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     if (ipv6_addr_is_multicast(&hdr->dst)) {
         _send_multicast(iface, pkt, ipv6, payload, prep_hdr);
     }
+#ifdef MODULE_GNRC_IPV6_DC
+    /* destination cache only holds destinations that are not ours */
+    else if ((dc_entry = gnrc_ipv6_dc_get(iface, &hdr->dst)) != NULL) {
+        DEBUG("ipv6: found %s in destination cache\n",
+              ipv6_addr_to_str(addr_str, &hdr->dst, sizeof(addr_str)));
+
+        if (prep_hdr) {
+            if (ipv6_addr_is_unspecified(&hdr->src)) {
+                /* stays unspecified if no source was selected before */
+                memcpy(&hdr->src, &dc_entry->src, sizeof(ipv6_addr_t));
+            }
+            if (_fill_ipv6_hdr(dc_entry->iface, ipv6, payload) < 0) {
+                /* error on filling up header */
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+        }
+
+        _send_unicast(dc_entry->iface, dc_entry->l2_addr,
+                      dc_entry->l2_addr_len, pkt);
+    }
+#endif
     else if ((ipv6_addr_is_loopback(&hdr->dst)) ||      /* dst is loopback address */
              ((iface == KERNEL_PID_UNDEF) && /* or dst registered to any local interface */
               ((iface = gnrc_ipv6_netif_find_by_addr(&tmp, &hdr->dst)) != KERNEL_PID_UNDEF)) ||
@@ -735,6 +789,10 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     else {
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
+#ifdef MODULE_GNRC_IPV6_DC
+        kernel_pid_t req_iface = iface;
+        bool select_src = prep_hdr && ipv6_addr_is_unspecified(&hdr->src);
+#endif
 
         iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, &hdr->dst, pkt);
 
@@ -752,6 +810,10 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
             }
         }
 
+#ifdef MODULE_GNRC_IPV6_DC
+        gnrc_ipv6_dc_add(req_iface, &hdr->dst, (select_src) ? &hdr->src : NULL,
+                         iface, l2addr, l2addr_len);
+#endif
         _send_unicast(iface, l2addr, l2addr_len, pkt);
     }
 }
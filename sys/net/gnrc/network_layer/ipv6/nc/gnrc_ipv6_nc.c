@@ -37,6 +37,121 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+/* entries by hash of their address */
+static gnrc_ipv6_nc_t *_buckets[GNRC_IPV6_NC_HASH_BUCKETS];
+/* entries that were used before and are free again */
+static gnrc_ipv6_nc_t *_free;
+/* number of entries that were never used */
+static unsigned _unused = GNRC_IPV6_NC_SIZE;
+/* entries in use from the least to the most recently used one */
+static gnrc_ipv6_nc_t *_lru, *_mru;
+
+/* an address is in the neighbor cache at most once, regardless of the
+ * interface, so the interface is not part of the hash */
+static inline gnrc_ipv6_nc_t **_bucket(const ipv6_addr_t *ipv6_addr)
+{
+    uint32_t hash = ipv6_addr->u32[0].u32 ^ ipv6_addr->u32[1].u32 ^
+                    ipv6_addr->u32[2].u32 ^ ipv6_addr->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return &_buckets[hash % GNRC_IPV6_NC_HASH_BUCKETS];
+}
+
+static gnrc_ipv6_nc_t *_lookup(const ipv6_addr_t *ipv6_addr)
+{
+    for (gnrc_ipv6_nc_t *entry = *_bucket(ipv6_addr); entry != NULL;
+         entry = entry->next) {
+        if (ipv6_addr_equal(&(entry->ipv6_addr), ipv6_addr)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void _unlink_use(gnrc_ipv6_nc_t *entry)
+{
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    }
+    else {
+        _lru = entry->newer;
+    }
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    }
+    else {
+        _mru = entry->older;
+    }
+}
+
+static void _link_use(gnrc_ipv6_nc_t *entry)
+{
+    entry->older = _mru;
+    entry->newer = NULL;
+    if (_mru != NULL) {
+        _mru->newer = entry;
+    }
+    else {
+        _lru = entry;
+    }
+    _mru = entry;
+}
+
+/* makes entry the most recently used one */
+static inline void _touch(gnrc_ipv6_nc_t *entry)
+{
+    if (entry != _mru) {
+        _unlink_use(entry);
+        _link_use(entry);
+    }
+}
+
+static void _index(gnrc_ipv6_nc_t *entry)
+{
+    gnrc_ipv6_nc_t **bucket = _bucket(&(entry->ipv6_addr));
+
+    entry->next = *bucket;
+    *bucket = entry;
+    _link_use(entry);
+}
+
+static void _unindex(gnrc_ipv6_nc_t *entry)
+{
+    gnrc_ipv6_nc_t **bucket = _bucket(&(entry->ipv6_addr));
+
+    while (*bucket != entry) {
+        bucket = &(*bucket)->next;
+    }
+    *bucket = entry->next;
+    _unlink_use(entry);
+    entry->next = _free;
+    _free = entry;
+}
+
+static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry);
+
+/* Removes the least recently used entry that may be replaced. Static
+ * entries, routers and registered addresses of 6LoWPAN-ND are kept, since
+ * they would not come back by themselves. */
+static bool _evict(void)
+{
+    for (gnrc_ipv6_nc_t *entry = _lru; entry != NULL; entry = entry->newer) {
+        uint8_t type = gnrc_ipv6_nc_get_type(entry);
+
+        if ((gnrc_ipv6_nc_get_state(entry) != GNRC_IPV6_NC_STATE_UNMANAGED) &&
+            !(entry->flags & GNRC_IPV6_NC_IS_ROUTER) &&
+            ((type == GNRC_IPV6_NC_TYPE_NONE) || (type == GNRC_IPV6_NC_TYPE_GC))) {
+            _nc_remove(entry->iface, entry);
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
     (void) iface;
@@ -48,6 +163,11 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
           ipv6_addr_to_str(addr_str, &(entry->ipv6_addr), sizeof(addr_str)),
           iface);
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    if (!ipv6_addr_is_unspecified(&(entry->ipv6_addr))) {
+        _unindex(entry);
+    }
+#endif
 #ifdef MODULE_GNRC_NDP_NODE
     while (entry->pkts != NULL) {
         gnrc_pktbuf_release(entry->pkts->pkt);
@@ -76,6 +196,7 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     ipv6_addr_set_unspecified(&(entry->ipv6_addr));
     entry->iface = KERNEL_PID_UNDEF;
     entry->flags = 0;
+    gnrc_ipv6_dc_invalidate();
 }
 
 void gnrc_ipv6_nc_init(void)
@@ -86,10 +207,30 @@ void gnrc_ipv6_nc_init(void)
         _nc_remove(entry->iface, entry);
     }
     memset(ncache, 0, sizeof(ncache));
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    memset(_buckets, 0, sizeof(_buckets));
+    _lru = NULL;
+    _mru = NULL;
+    _free = NULL;
+    _unused = GNRC_IPV6_NC_SIZE;
+#endif
 }
 
 gnrc_ipv6_nc_t *_find_free_entry(void)
 {
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    gnrc_ipv6_nc_t *entry;
+
+    if (_unused > 0) {
+        return &ncache[GNRC_IPV6_NC_SIZE - _unused--];
+    }
+    if ((_free == NULL) && !_evict()) {
+        return NULL;
+    }
+    entry = _free;
+    _free = entry->next;
+    return entry;
+#else
     for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
         if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr))) {
             return ncache + i;
@@ -97,6 +238,26 @@ gnrc_ipv6_nc_t *_find_free_entry(void)
     }
 
     return NULL;
+#endif
+}
+
+static void _nc_update(gnrc_ipv6_nc_t *entry, const void *l2_addr,
+                       size_t l2_addr_len, uint8_t flags)
+{
+    DEBUG("ipv6_nc: Address %s already registered.\n",
+          ipv6_addr_to_str(addr_str, &(entry->ipv6_addr), sizeof(addr_str)));
+
+    if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+        DEBUG("ipv6_nc: Update to L2 address %s",
+              gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                     l2_addr, l2_addr_len));
+
+        memcpy(&(entry->l2_addr), l2_addr, l2_addr_len);
+        entry->l2_addr_len = l2_addr_len;
+        entry->flags = flags;
+        DEBUG(" with flags = 0x%0x\n", flags);
+        gnrc_ipv6_dc_invalidate();
+    }
 }
 
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr,
@@ -114,22 +275,20 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    gnrc_ipv6_nc_t *entry = _lookup(ipv6_addr);
 
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                             l2_addr, l2_addr_len));
-
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
+    if (entry != NULL) {
+        _nc_update(entry, l2_addr, l2_addr_len, flags);
+        _touch(entry);
+        return entry;
+    }
 
-            }
+    free_entry = _find_free_entry();
+#else
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
+            _nc_update(&ncache[i], l2_addr, l2_addr_len, flags);
             return &ncache[i];
         }
 
@@ -138,6 +297,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
             free_entry = &ncache[i];
         }
     }
+#endif
 
     if (!free_entry) {
         /* reached end of NC without finding updateable or free entry */
@@ -165,6 +325,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
     }
 
     free_entry->flags = flags;
+    gnrc_ipv6_dc_invalidate();
 
     DEBUG(" with flags = 0x%0x\n", flags);
 
@@ -188,6 +349,10 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
 
     free_entry->nbr_sol_msg.content.ptr = (char *) free_entry;
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    _index(free_entry);
+#endif
+
     return free_entry;
 }
 
@@ -204,6 +369,21 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+    gnrc_ipv6_nc_t *entry = _lookup(ipv6_addr);
+
+    if ((entry != NULL) &&
+        ((entry->iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+         (iface == entry->iface))) {
+        DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
+              " (0 = all interfaces) [%p]\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
+              iface, (void *)entry);
+
+        _touch(entry);
+        return entry;
+    }
+#else
     for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
         if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
              (iface == ncache[i].iface)) &&
@@ -216,6 +396,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
             return ncache + i;
         }
     }
+#endif
 
     return NULL;
 }
@@ -275,6 +456,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_still_reachable(const ipv6_addr_t *ipv6_addr)
               ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
         entry->flags &= ~(GNRC_IPV6_NC_STATE_MASK >> GNRC_IPV6_NC_STATE_POS);
         entry->flags |= (GNRC_IPV6_NC_STATE_REACHABLE >> GNRC_IPV6_NC_STATE_POS);
+        gnrc_ipv6_dc_invalidate();
     }
 
     return entry;
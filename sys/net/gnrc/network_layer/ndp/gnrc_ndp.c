@@ -314,6 +314,7 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
                 /* TODO: update state of neighbor as router in FIB? */
             }
+            gnrc_ipv6_dc_invalidate();
 #ifdef MODULE_GNRC_NDP_NODE
             gnrc_pktqueue_t *queued_pkt;
             while ((queued_pkt = gnrc_pktqueue_remove_head(&nc_entry->pkts)) != NULL) {
@@ -362,6 +363,7 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                     nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
                     /* TODO: update state of neighbor as router in FIB? */
                 }
+                gnrc_ipv6_dc_invalidate();
             }
             else if (l2tgt_changed &&
                      gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_REACHABLE) {
@@ -472,6 +474,7 @@ void gnrc_ndp_rtr_sol_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
             /* unset isRouter flag
              * (https://tools.ietf.org/html/rfc4861#section-6.2.6) */
             nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+            gnrc_ipv6_dc_invalidate();
         }
     }
     /* otherwise ignore silently */
@@ -523,8 +526,12 @@ void gnrc_ndp_rtr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt, ipv6_hdr_t
     }
     else if ((nc_entry->flags & GNRC_IPV6_NC_IS_ROUTER) && (byteorder_ntohs(rtr_adv->ltime) == 0)) {
         nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+        gnrc_ipv6_dc_invalidate();
     }
     else {
+        if (!(nc_entry->flags & GNRC_IPV6_NC_IS_ROUTER)) {
+            gnrc_ipv6_dc_invalidate();
+        }
         nc_entry->flags |= GNRC_IPV6_NC_IS_ROUTER;
     }
     /* set router life timer */
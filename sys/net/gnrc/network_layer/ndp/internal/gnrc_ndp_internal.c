@@ -95,6 +95,7 @@ void gnrc_ndp_internal_set_state(gnrc_ipv6_nc_t *nc_entry, uint8_t state)
 
     nc_entry->flags &= ~GNRC_IPV6_NC_STATE_MASK;
     nc_entry->flags |= state;
+    gnrc_ipv6_dc_invalidate();
 
     DEBUG("ndp internal: set %s state to ",
           ipv6_addr_to_str(addr_str, &nc_entry->ipv6_addr, sizeof(addr_str)));
@@ -799,6 +800,7 @@ bool gnrc_ndp_internal_pi_opt_handle(kernel_pid_t iface, uint8_t icmpv6_type,
     /* on-link flag MUST stay set if it was */
     netif_addr->flags &= NDP_OPT_PI_FLAGS_L;
     netif_addr->flags |= (pi_opt->flags & NDP_OPT_PI_FLAGS_MASK);
+    gnrc_ipv6_dc_invalidate();
     return true;
 }
 
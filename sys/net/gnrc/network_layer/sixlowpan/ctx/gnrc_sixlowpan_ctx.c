@@ -15,6 +15,7 @@
 #include <stdbool.h>
 #include <inttypes.h>
 
+#include "irq.h"
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "xtimer.h"
@@ -25,6 +26,10 @@
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
+/* changes whenever a context changes in a way that affects compression */
+static uint32_t _generation;
+/* earliest minute a context with a lifetime may expire */
+static uint32_t _next_inval;
 
 static uint32_t _current_minute(void);
 static void _update_lifetime(uint8_t id);
@@ -33,6 +38,15 @@ static void _update_lifetime(uint8_t id);
 static char ipv6str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+static inline void _changed(void)
+{
+    /* contexts may also be removed from interrupt context */
+    unsigned state = irq_disable();
+
+    _generation++;
+    irq_restore(state);
+}
+
 static inline bool _valid(uint8_t id)
 {
     _update_lifetime(id);
@@ -126,11 +140,48 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    if ((ltime != 0) && (_ctx_inval_times[id] < _next_inval)) {
+        _next_inval = _ctx_inval_times[id];
+    }
+    _changed();
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id < GNRC_SIXLOWPAN_CTX_SIZE) {
+        _ctxs[id].prefix_len = 0;
+        _changed();
+    }
+}
+
+uint32_t gnrc_sixlowpan_ctx_generation(void)
+{
+    uint32_t res;
+
+    mutex_lock(&_ctx_mutex);
+
+    /* lifetimes are only updated on lookup, so let the contexts that ran out
+     * expire now */
+    if (_current_minute() >= _next_inval) {
+        _next_inval = UINT32_MAX;
+        for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+            if (_ctxs[id].ltime != 0) {
+                _update_lifetime(id);
+            }
+            if ((_ctxs[id].ltime != 0) && (_ctx_inval_times[id] < _next_inval)) {
+                _next_inval = _ctx_inval_times[id];
+            }
+        }
+    }
+    res = _generation;
+
+    mutex_unlock(&_ctx_mutex);
+    return res;
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now() / (SEC_IN_USEC * 60);
@@ -151,6 +202,7 @@ static void _update_lifetime(uint8_t id)
         DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
         _ctxs[id].ltime = 0;
         _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+        _changed();
     }
     else {
         _ctxs[id].ltime = (uint16_t)(_ctx_inval_times[id] - now);
@@ -163,6 +215,7 @@ static void _update_lifetime(uint8_t id)
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _changed();
 }
 #endif
 
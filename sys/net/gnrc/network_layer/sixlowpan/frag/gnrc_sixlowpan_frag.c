@@ -37,6 +37,10 @@
 
 static uint16_t _tag;
 
+/* fragmentation jobs, FIFO: only the head is sent */
+static gnrc_sixlowpan_msg_frag_t _jobs[GNRC_SIXLOWPAN_FRAG_JOB_NUMOF];
+static unsigned _jobs_head, _jobs_numof;
+
 static inline uint16_t _floor8(uint16_t length)
 {
     return length & 0xf8U;
@@ -82,7 +86,8 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
 }
 
 static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
@@ -110,7 +115,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
     pkt = pkt->next;    /* don't copy netif header */
 
@@ -129,7 +134,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
+          (unsigned int)datagram_size, tag, local_offset);
     if (gnrc_netapi_send(iface->pid, frag) < 1) {
         DEBUG("6lo frag: unable to send first fragment\n");
         gnrc_pktbuf_release(frag);
@@ -140,7 +145,7 @@ static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
 
 static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   uint16_t offset, uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
@@ -166,7 +171,7 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
     hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
     pkt = pkt->next;    /* don't copy netif header */
@@ -206,7 +211,7 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
     if (gnrc_netapi_send(iface->pid, frag) < 1) {
         DEBUG("6lo frag: unable to send subsequent fragment\n");
@@ -216,69 +221,107 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     return local_offset;
 }
 
-void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+static void _finish_job(void)
+{
+    gnrc_pktbuf_release(_jobs[_jobs_head].pkt);
+    _jobs[_jobs_head].pkt = NULL;
+    _jobs_head = (_jobs_head + 1) % GNRC_SIXLOWPAN_FRAG_JOB_NUMOF;
+    _jobs_numof--;
+}
+
+static void _send_next_fragment(void)
 {
-    gnrc_sixlowpan_netif_t *iface = gnrc_sixlowpan_netif_get(fragment_msg->pid);
+    gnrc_sixlowpan_msg_frag_t *job = &_jobs[_jobs_head];
+    gnrc_sixlowpan_netif_t *iface = gnrc_sixlowpan_netif_get(job->pid);
     uint16_t res;
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
-    size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
+    size_t payload_len = gnrc_pkt_len(job->pkt->next);
 
-#if defined(DEVELHELP) && defined(ENABLE_DEBUG)
     if (iface == NULL) {
-        DEBUG("6lo frag: iface == NULL, expect segmentation fault.\n");
-        /* remove original packet from packet buffer */
-        gnrc_pktbuf_release(fragment_msg->pkt);
-        /* 6LoWPAN free for next fragmentation */
-        fragment_msg->pkt = NULL;
+        DEBUG("6lo frag: interface %" PRIkernel_pid " is gone, dropping "
+              "packet\n", job->pid);
+        _finish_job();
         return;
     }
-#endif
 
     /* Check weater to send the first or an Nth fragment */
-    if (fragment_msg->offset == 0) {
-        /* increment tag for successive, fragmented datagrams */
-        _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
-            /* error sending first fragment */
-            DEBUG("6lo frag: error sending 1st fragment\n");
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
+    if (job->offset == 0) {
+        res = _send_1st_fragment(iface, job->pkt, payload_len,
+                                 job->datagram_size, job->tag);
+    }
+    else {
+        res = _send_nth_fragment(iface, job->pkt, payload_len,
+                                 job->datagram_size, job->offset, job->tag);
+    }
+
+    if (res == 0) {
+        DEBUG("6lo frag: error sending fragment (offset = %" PRIu16 ")\n",
+              job->offset);
+        _finish_job();
+        return;
+    }
+    job->offset += res;
+
+    /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
+    if (job->offset >= payload_len) {
+        _finish_job();
+    }
+}
+
+/* Wakes the calling thread up again for the next fragments. If its message
+ * queue is full, the fragments are sent right away rather than stalling the
+ * queued packets. */
+static void _continue(void)
+{
+    while (_jobs_numof > 0) {
+        msg_t msg;
+
+        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+        msg.content.ptr = NULL;
+        if (msg_send_to_self(&msg) == 1) {
             return;
         }
-        fragment_msg->offset += res;
+        DEBUG("6lo frag: message queue full, sending fragment right away\n");
+        _send_next_fragment();
+    }
+}
 
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
+bool gnrc_sixlowpan_frag_enqueue(kernel_pid_t pid, gnrc_pktsnip_t *pkt,
+                                 size_t datagram_size)
+{
+    gnrc_sixlowpan_msg_frag_t *job;
+
+    if (_jobs_numof == GNRC_SIXLOWPAN_FRAG_JOB_NUMOF) {
+        DEBUG("6lo frag: fragmentation queue full\n");
+        return false;
     }
-    else {
-        /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
-        if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
-                /* error sending subsequent fragment */
-                DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
-                      ")\n", fragment_msg->offset);
-                gnrc_pktbuf_release(fragment_msg->pkt);
-                fragment_msg->pkt = NULL;
-                return;
-                }
-            fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
-        }
-        else {
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
-        }
+
+    job = &_jobs[(_jobs_head + _jobs_numof) % GNRC_SIXLOWPAN_FRAG_JOB_NUMOF];
+    job->pid = pid;
+    job->pkt = pkt;
+    job->datagram_size = datagram_size;
+    /* Sending the first fragment has an offset==0 */
+    job->offset = 0;
+    /* increment tag for successive, fragmented datagrams */
+    job->tag = ++_tag;
+
+    /* the message for the other packets is pending already */
+    if (++_jobs_numof == 1) {
+        _continue();
+    }
+    return true;
+}
+
+void gnrc_sixlowpan_frag_send(void)
+{
+    for (unsigned i = 0; (i < GNRC_SIXLOWPAN_FRAG_BUDGET) && (_jobs_numof > 0); i++) {
+        _send_next_fragment();
+    }
+
+    if (_jobs_numof > 0) {
+        _continue();
+        thread_yield();
     }
 }
 
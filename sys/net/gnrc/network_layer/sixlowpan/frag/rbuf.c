@@ -29,22 +29,26 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
-#endif
-
-#ifndef RBUF_INT_SIZE
 /* same as ((int) ceil((double) N / D)) */
 #define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(GNRC_IPV6_NETIF_DEFAULT_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
-#endif
 
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+/* results of _rbuf_check_frag() */
+enum {
+    RBUF_FRAG_NEW = 0,      /* fragment covers no received data */
+    RBUF_FRAG_DUPLICATE,    /* fragment was received before */
+    RBUF_FRAG_OVERLAP,      /* fragment overlaps a different fragment */
+};
 
 static rbuf_t rbuf[RBUF_SIZE];
+/* entries by hash of their tuple */
+static rbuf_t *_buckets[RBUF_BUCKETS];
+/* entries that were used before and are free again */
+static rbuf_t *_free;
+/* number of entries that were never used */
+static unsigned _unused = RBUF_SIZE;
+/* all entries in use, ordered by arrival of their last fragment. Since every
+ * entry has the same timeout this is also the order they time out in */
+static rbuf_t *_oldest, *_newest;
 
 #if ENABLE_DEBUG
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
@@ -53,15 +57,13 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
+/* checks how a fragment relates to the ones already received */
+static int _rbuf_check_frag(rbuf_t *entry, uint16_t offset, size_t frag_size);
+/* marks the units of a fragment as received */
+static void _rbuf_mark_frag(rbuf_t *entry, uint16_t offset, size_t frag_size);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
+/* checks timeouts and removes entries if necessary */
 static void _rbuf_gc(void);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
@@ -77,7 +79,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     unsigned int data_offset = 0;
     size_t original_size = frag_size;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
 
     _rbuf_gc();
@@ -91,8 +92,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
         if (data[0] == SIXLOWPAN_UNCOMP) {
@@ -130,11 +129,23 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    /* If the fragment overlaps another fragment and differs in either the size
-     * or the offset of the overlapped fragment, discards the datagram
-     * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
+    switch (_rbuf_check_frag(entry, offset, frag_size)) {
+        case RBUF_FRAG_NEW:
+            DEBUG("6lo rbuf: add fragment data\n");
+            _rbuf_mark_frag(entry, offset, frag_size);
+            entry->cur_size += (uint16_t)frag_size;
+            memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
+                   frag_size - data_offset);
+            break;
+
+        case RBUF_FRAG_DUPLICATE:
+            DEBUG("6lo rbuf: duplicate fragment, ignoring it\n");
+            return;
+
+        default:
+            /* If the fragment overlaps another fragment and differs in either
+             * the size or the offset of the overlapped fragment, discards the
+             * datagram https://tools.ietf.org/html/rfc4944#section-5.3 */
             DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
             gnrc_pktbuf_release(entry->pkt);
             _rbuf_rem(entry);
@@ -143,18 +154,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
              * received link fragment"
              * https://tools.ietf.org/html/rfc4944#section-5.3 */
             rbuf_add(netif_hdr, pkt, original_size, offset);
-
             return;
-        }
-
-        ptr = ptr->next;
-    }
-
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
-        entry->cur_size += (uint16_t)frag_size;
-        memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
-               frag_size - data_offset);
     }
 
     if (entry->cur_size == entry->pkt->size) {
@@ -189,151 +189,220 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     }
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
+static int _rbuf_check_frag(rbuf_t *entry, uint16_t offset, size_t frag_size)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
-}
+    unsigned start = offset / 8U;
+    unsigned end = DIV_CEIL(offset + frag_size, 8U);
+    unsigned received = 0;
 
-static rbuf_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+    for (unsigned i = start; i < end; i++) {
+        if (bf_isset(entry->received, i)) {
+            received++;
         }
     }
-
-    return NULL;
+    if (received == 0) {
+        return RBUF_FRAG_NEW;
+    }
+    /* a duplicate covers exactly the units of one received fragment: that
+     * fragment started at the same unit ... */
+    if ((received < (end - start)) || !bf_isset(entry->starts, start)) {
+        return RBUF_FRAG_OVERLAP;
+    }
+    /* ... no other fragment started within ... */
+    for (unsigned i = start + 1; i < end; i++) {
+        if (bf_isset(entry->starts, i)) {
+            return RBUF_FRAG_OVERLAP;
+        }
+    }
+    /* ... and it did not go on after the end */
+    if ((end < DIV_CEIL(entry->pkt->size, 8U)) &&
+        bf_isset(entry->received, end) && !bf_isset(entry->starts, end)) {
+        return RBUF_FRAG_OVERLAP;
+    }
+    return RBUF_FRAG_DUPLICATE;
 }
 
-static void _rbuf_rem(rbuf_t *entry)
+static void _rbuf_mark_frag(rbuf_t *entry, uint16_t offset, size_t frag_size)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    unsigned end = DIV_CEIL(offset + frag_size, 8U);
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
-    }
+    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %u) to entry (%s, ",
+          offset, (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), entry->src,
+                                 entry->src_len));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
+            sizeof(l2addr_str), entry->dst, entry->dst_len),
+          (unsigned)entry->pkt->size, entry->tag);
 
-    entry->pkt = NULL;
+    bf_set(entry->starts, offset / 8U);
+    for (unsigned i = offset / 8U; i < end; i++) {
+        bf_set(entry->received, i);
+    }
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static inline unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                                  size_t size, uint16_t tag)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    /* the destination is mostly this node, so it is left out */
+    uint32_t hash = ((uint32_t)tag << 11) ^ size;
 
-    new = _rbuf_int_get_free();
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
+    }
+    return hash % RBUF_BUCKETS;
+}
 
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+/* takes entry out of the arrival order */
+static void _rbuf_unlink_arrival(rbuf_t *entry)
+{
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    }
+    else {
+        _oldest = entry->newer;
     }
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    }
+    else {
+        _newest = entry->older;
+    }
+}
 
-    new->start = offset;
-    new->end = end;
+/* makes entry the one with the latest arrival */
+static void _rbuf_arrived(rbuf_t *entry, uint32_t now_usec)
+{
+    entry->arrival = now_usec;
+    entry->older = _newest;
+    entry->newer = NULL;
+    if (_newest != NULL) {
+        _newest->newer = entry;
+    }
+    else {
+        _oldest = entry;
+    }
+    _newest = entry;
+}
 
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(l2addr_str,
-                  sizeof(l2addr_str), entry->src, entry->src_len));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
-            sizeof(l2addr_str), entry->dst, entry->dst_len),
-          (unsigned)entry->pkt->size, entry->tag);
+static void _rbuf_rem(rbuf_t *entry)
+{
+    rbuf_t **bucket = &_buckets[_rbuf_hash(entry->src, entry->src_len,
+                                           entry->size, entry->tag)];
 
-    LL_PREPEND(entry->ints, new);
+    while (*bucket != entry) {
+        bucket = &(*bucket)->next;
+    }
+    *bucket = entry->next;
+    _rbuf_unlink_arrival(entry);
 
-    return true;
+    entry->pkt = NULL;
+    entry->next = _free;
+    _free = entry;
 }
 
 static void _rbuf_gc(void)
 {
     uint32_t now_usec = xtimer_now();
-    unsigned int i;
-
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
-                    sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), rbuf[i].dst,
-                                         rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            _rbuf_rem(&(rbuf[i]));
+
+    /* since pkt occupies pktbuf, aggressivly collect garbage */
+    while ((_oldest != NULL) && ((now_usec - _oldest->arrival) > RBUF_TIMEOUT)) {
+        DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), _oldest->src, _oldest->src_len));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), _oldest->dst,
+                                     _oldest->dst_len),
+              (unsigned)_oldest->pkt->size, _oldest->tag);
+
+        gnrc_pktbuf_release(_oldest->pkt);
+        _rbuf_rem(_oldest);
+    }
+}
+
+/* Removes the oldest entry of a datagram at least as large as a new one of
+ * size. So a flood of large datagrams can't push out the smaller ones which
+ * need fewer fragments and less packet buffer space to complete. */
+static bool _rbuf_evict(size_t size)
+{
+    for (rbuf_t *entry = _oldest; entry != NULL; entry = entry->newer) {
+        if (entry->size >= size) {
+            DEBUG("6lo rfrag: remove entry (%s, ", gnrc_netif_addr_to_str(
+                    l2addr_str, sizeof(l2addr_str), entry->src, entry->src_len));
+            DEBUG("%s, %u, %u) to make room\n",
+                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                         entry->dst, entry->dst_len),
+                  (unsigned)entry->pkt->size, entry->tag);
+            gnrc_pktbuf_release(entry->pkt);
+            _rbuf_rem(entry);
+            return true;
         }
     }
+    return false;
 }
 
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
+    rbuf_t *res, **bucket = &_buckets[_rbuf_hash(src, src_len, size, tag)];
     uint32_t now_usec = xtimer_now();
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
+    /* check first if entry already available */
+    for (res = *bucket; res != NULL; res = res->next) {
+        if ((res->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
                   gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].src, rbuf[i].src_len));
+                                         res->src, res->src_len));
             DEBUG("%s, %u, %u) found\n",
                   gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].dst, rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-            rbuf[i].arrival = now_usec;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
-            res = &(rbuf[i]);
-        }
-
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
+                                         res->dst, res->dst_len),
+                  (unsigned)res->pkt->size, res->tag);
+            _rbuf_unlink_arrival(res);
+            _rbuf_arrived(res, now_usec);
+            return res;
         }
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        assert(oldest->pkt != NULL); /* if oldest->pkt == NULL, res must not be NULL */
-        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->pkt);
-        _rbuf_rem(oldest);
-        res = oldest;
+    if ((_free == NULL) && (_unused == 0) && !_rbuf_evict(size)) {
+        DEBUG("6lo rfrag: reassembly buffer full of smaller datagrams\n");
+        return NULL;
     }
 
     /* now we have an empty spot */
+    if (_free != NULL) {
+        res = _free;
+        _free = res->next;
+    }
+    else {
+        res = &rbuf[--_unused];
+    }
 
-    res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
-    if (res->pkt == NULL) {
-        DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
-        return NULL;
+    while ((res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6)) == NULL) {
+        if (!_rbuf_evict(size)) {
+            DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+            res->next = _free;
+            _free = res;
+            return NULL;
+        }
     }
 
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
                                          * look-ups */
-    res->arrival = now_usec;
+    memset(res->received, 0, sizeof(res->received));
+    memset(res->starts, 0, sizeof(res->starts));
     memcpy(res->src, src, src_len);
     memcpy(res->dst, dst, dst_len);
     res->src_len = src_len;
     res->dst_len = dst_len;
     res->tag = tag;
+    res->size = (uint16_t)size;
     res->cur_size = 0;
+    /* the bucket may have changed while evicting */
+    res->next = *bucket;
+    *bucket = res;
+    _rbuf_arrived(res, now_usec);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
@@ -346,4 +415,14 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     return res;
 }
 
+#ifdef TEST_SUITES
+void rbuf_reset(void)
+{
+    while (_oldest != NULL) {
+        gnrc_pktbuf_release(_oldest->pkt);
+        _rbuf_rem(_oldest);
+    }
+}
+#endif
+
 /** @} */
@@ -21,6 +21,7 @@
 
 #include <inttypes.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
 
@@ -31,26 +32,18 @@ extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
+#ifndef RBUF_SIZE
 #define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
+#endif
+#ifndef RBUF_BUCKETS
+#define RBUF_BUCKETS        (RBUF_SIZE)        /**< number of hash buckets to find entries */
+#endif
 #define RBUF_TIMEOUT        (3U * SEC_IN_USEC) /**< timeout for reassembly in microseconds */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
- *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
- *
- * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
- *          RFC 4944, section 5.3
- *      </a>
- *
- * @internal
+ * @brief   Number of 8-byte units of the largest datagram
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_UNITS          ((SIXLOWPAN_FRAG_MAX_LEN + 7U) / 8U)
 
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
@@ -59,27 +52,36 @@ typedef struct rbuf_int {
  *
  * 1. the source address,
  * 2. the destination address,
- * 3. the datagram size (gnrc_pktsnip_t::size of rbuf_t::pkt), and
+ * 3. the datagram size, and
  * 4. the datagram tag
  *
  * to identify all fragments that belong to the given datagram.
  *
+ * Fragment offsets are multiples of 8 bytes, so the received parts of the
+ * datagram are tracked in units of 8 bytes.
+ *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
  *
  * @internal
  */
-typedef struct {
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
+typedef struct rbuf {
+    struct rbuf *next;                  /**< next entry in hash bucket or list of
+                                         *   free entries */
+    struct rbuf *older;                 /**< entry with the previous arrival */
+    struct rbuf *newer;                 /**< entry with the next arrival */
     gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
+    BITFIELD(received, RBUF_UNITS);     /**< units of the datagram received */
+    BITFIELD(starts, RBUF_UNITS);       /**< units a received fragment starts at */
     uint8_t src[RBUF_L2ADDR_MAX_LEN];   /**< source address */
     uint8_t dst[RBUF_L2ADDR_MAX_LEN];   /**< destination address */
     uint8_t src_len;                    /**< length of source address */
     uint8_t dst_len;                    /**< length of destination address */
     uint16_t tag;                       /**< the datagram's tag */
+    uint16_t size;                      /**< the datagram's size */
     uint16_t cur_size;                  /**< the datagram's current size */
 } rbuf_t;
 
@@ -100,6 +102,16 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t frag_size, size_t offset);
 
+/* for testing */
+#ifdef TEST_SUITES
+/**
+ * @brief   Removes all entries from the reassembly buffer
+ *
+ * @internal
+ */
+void rbuf_reset(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,9 @@
 #include "utlist.h"
 
 #include "net/gnrc/ipv6/hdr.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netapi/direct.h"
+#endif
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/iphc.h"
@@ -34,23 +37,25 @@
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0};
-#endif
-
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 #if ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
 #endif
+#endif
 
 
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* handles GNRC_NETAPI_MSG_TYPE_SND commands */
 static void _send(gnrc_pktsnip_t *pkt);
+/* handles a message for 6LoWPAN, returns false for unknown message types */
+static bool _handle_msg(msg_t *msg);
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 /* Main event loop for 6LoWPAN */
 static void *_event_loop(void *args);
+#endif
 
 kernel_pid_t gnrc_sixlowpan_init(void)
 {
@@ -58,8 +63,12 @@ kernel_pid_t gnrc_sixlowpan_init(void)
         return _pid;
     }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    _pid = gnrc_netapi_direct_register(GNRC_NETTYPE_SIXLOWPAN, _handle_msg);
+#else
     _pid = thread_create(_stack, sizeof(_stack), GNRC_SIXLOWPAN_PRIO,
                          THREAD_CREATE_STACKTEST, _event_loop, NULL, "6lo");
+#endif
 
     return _pid;
 }
@@ -272,27 +281,14 @@ static void _send(gnrc_pktsnip_t *pkt)
         return;
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-    else if (fragment_msg.pkt != NULL) {
-        DEBUG("6lo: Fragmentation already ongoing. Dropping packet\n");
-        gnrc_pktbuf_release(pkt2);
-        return;
-    }
     else if (datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %" PRIu16 ")\n",
               (unsigned int)datagram_size, iface->max_frag_size);
-        msg_t msg;
-
-        fragment_msg.pid = hdr->if_pid;
-        fragment_msg.pkt = pkt2;
-        fragment_msg.datagram_size = datagram_size;
-        /* Sending the first fragment has an offset==0 */
-        fragment_msg.offset = 0;
-
-        /* set the outgoing message's fields */
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)&fragment_msg;
-        /* send message to self */
-        msg_send_to_self(&msg);
+        if (!gnrc_sixlowpan_frag_enqueue(hdr->if_pid, pkt2, datagram_size)) {
+            DEBUG("6lo: Too many packets waiting for fragmentation. "
+                  "Dropping packet\n");
+            gnrc_pktbuf_release(pkt2);
+        }
     }
     else {
         DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
@@ -307,9 +303,46 @@ static void _send(gnrc_pktsnip_t *pkt)
 #endif
 }
 
+static bool _handle_msg(msg_t *msg)
+{
+    msg_t reply;
+
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
+            _receive((gnrc_pktsnip_t *)msg->content.ptr);
+            break;
+
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
+            _send((gnrc_pktsnip_t *)msg->content.ptr);
+            break;
+
+        case GNRC_NETAPI_MSG_TYPE_GET:
+        case GNRC_NETAPI_MSG_TYPE_SET:
+            DEBUG("6lo: reply to unsupported get/set\n");
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = -ENOTSUP;
+            msg_reply(msg, &reply);
+            break;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+        case GNRC_SIXLOWPAN_MSG_FRAG_SND:
+            DEBUG("6lo: send fragmented event received\n");
+            gnrc_sixlowpan_frag_send();
+            break;
+#endif
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 static void *_event_loop(void *args)
 {
-    msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+    msg_t msg, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
     gnrc_netreg_entry_t me_reg;
 
     (void)args;
@@ -321,45 +354,18 @@ static void *_event_loop(void *args)
     /* register interest in all 6LoWPAN packets */
     gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &me_reg);
 
-    /* preinitialize ACK */
-    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-
     /* start event loop */
     while (1) {
         DEBUG("6lo: waiting for incoming message.\n");
         msg_receive(&msg);
 
-        switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
-                _receive((gnrc_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
-                _send((gnrc_pktsnip_t *)msg.content.ptr);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_GET:
-            case GNRC_NETAPI_MSG_TYPE_SET:
-                DEBUG("6lo: reply to unsupported get/set\n");
-                reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
-                break;
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-            case GNRC_SIXLOWPAN_MSG_FRAG_SND:
-                DEBUG("6lo: send fragmented event received\n");
-                gnrc_sixlowpan_frag_send((gnrc_sixlowpan_msg_frag_t *)msg.content.ptr);
-                break;
-#endif
-
-            default:
-                DEBUG("6lo: operation not supported\n");
-                break;
+        if (!_handle_msg(&msg)) {
+            DEBUG("6lo: operation not supported\n");
         }
     }
 
     return NULL;
 }
+#endif
 
 /** @} */
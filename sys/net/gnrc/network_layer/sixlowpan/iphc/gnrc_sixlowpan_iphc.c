@@ -582,6 +582,152 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
 }
 #endif
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+/* IPHC dispatch, CID extension, traffic class and flow label, next header,
+ * hop limit and both addresses carried inline */
+#define IPHC_HDR_MAX_LEN    (SIXLOWPAN_IPHC_HDR_LEN + SIXLOWPAN_IPHC_CID_EXT_LEN + \
+                             4 + 1 + 1 + (2 * sizeof(ipv6_addr_t)))
+#define IPHC_L2ADDR_MAX     (IEEE802154_LONG_ADDRESS_LEN)
+
+/* compressed header of a flow */
+typedef struct {
+    ipv6_addr_t src;                    /* IPv6 source address */
+    ipv6_addr_t dst;                    /* IPv6 destination address */
+    eui64_t iid;                        /* IID taken from the driver */
+    uint32_t ctx_generation;            /* generation of the contexts used */
+    network_uint32_t v_tc_fl;           /* version, traffic class and flow label */
+    network_uint16_t ports[2];          /* UDP ports, if compressed with NHC */
+    kernel_pid_t if_pid;                /* interface */
+    uint8_t nh;                         /* next header */
+    uint8_t hl;                         /* hop limit */
+    uint8_t src_l2addr_len;             /* length of src_l2addr */
+    uint8_t dst_l2addr_len;             /* length of dst_l2addr */
+    uint8_t src_l2addr[IPHC_L2ADDR_MAX];    /* link layer source address */
+    uint8_t dst_l2addr[IPHC_L2ADDR_MAX];    /* link layer destination address */
+    bool driver_iid;                    /* source IID was taken from the driver */
+    uint8_t hl_pos;                     /* position of inline hop limit, 0 if elided */
+    uint8_t len;                        /* length of hdr, 0 if not compressed yet */
+    uint8_t hdr[IPHC_HDR_MAX_LEN];      /* the compressed header */
+} _flow_t;
+
+static _flow_t _flows[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _flows_next;
+
+static inline bool _hl_inline(uint8_t hl)
+{
+    return (hl != 1) && (hl != 64) && (hl != 255);
+}
+
+static bool _flow_match(const _flow_t *flow, gnrc_netif_hdr_t *netif_hdr,
+                        const ipv6_hdr_t *ipv6_hdr, const network_uint16_t *ports,
+                        uint32_t ctx_generation)
+{
+    return (flow->len > 0) &&
+           ipv6_addr_equal(&flow->dst, &ipv6_hdr->dst) &&
+           ipv6_addr_equal(&flow->src, &ipv6_hdr->src) &&
+           (flow->v_tc_fl.u32 == ipv6_hdr->v_tc_fl.u32) &&
+           (flow->nh == ipv6_hdr->nh) &&
+           /* an inline hop limit is patched */
+           ((flow->hl == ipv6_hdr->hl) ||
+            ((flow->hl_pos != 0) && _hl_inline(ipv6_hdr->hl))) &&
+           (flow->ports[0].u16 == ports[0].u16) &&
+           (flow->ports[1].u16 == ports[1].u16) &&
+           (flow->ctx_generation == ctx_generation) &&
+           (flow->if_pid == netif_hdr->if_pid) &&
+           (flow->src_l2addr_len == netif_hdr->src_l2addr_len) &&
+           (flow->dst_l2addr_len == netif_hdr->dst_l2addr_len) &&
+           (memcmp(flow->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                   flow->src_l2addr_len) == 0) &&
+           (memcmp(flow->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                   flow->dst_l2addr_len) == 0);
+}
+
+/* returns the entry of the packet's flow. It was not compressed yet, if its
+ * length is 0. Returns NULL if the flow can not be cached. */
+static _flow_t *_flow_get(gnrc_netif_hdr_t *netif_hdr, const ipv6_hdr_t *ipv6_hdr,
+                          gnrc_pktsnip_t *nh_snip)
+{
+    network_uint16_t ports[2] = { { 0 }, { 0 } };
+    uint32_t ctx_generation = gnrc_sixlowpan_ctx_generation();
+    _flow_t *flow = NULL;
+
+    if ((netif_hdr->src_l2addr_len > IPHC_L2ADDR_MAX) ||
+        (netif_hdr->dst_l2addr_len > IPHC_L2ADDR_MAX)) {
+        return NULL;
+    }
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+    if (ipv6_hdr->nh == PROTNUM_UDP) {
+        udp_hdr_t *udp_hdr = nh_snip->data;
+
+        ports[0] = udp_hdr->src_port;
+        ports[1] = udp_hdr->dst_port;
+    }
+#else
+    (void)nh_snip;
+#endif
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        if (_flow_match(&_flows[i], netif_hdr, ipv6_hdr, ports, ctx_generation)) {
+            eui64_t iid;
+
+            if (!_flows[i].driver_iid) {
+                return &_flows[i];
+            }
+            gnrc_netapi_get(netif_hdr->if_pid, NETOPT_IPV6_IID, 0, &iid,
+                            sizeof(eui64_t));
+            if (iid.uint64.u64 == _flows[i].iid.uint64.u64) {
+                return &_flows[i];
+            }
+            /* the interface's IID changed: compress the flow anew */
+            flow = &_flows[i];
+            break;
+        }
+    }
+
+    if (flow == NULL) {
+        flow = &_flows[_flows_next];
+        _flows_next = (_flows_next + 1) % GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    }
+
+    memcpy(&flow->src, &ipv6_hdr->src, sizeof(ipv6_addr_t));
+    memcpy(&flow->dst, &ipv6_hdr->dst, sizeof(ipv6_addr_t));
+    flow->ctx_generation = ctx_generation;
+    flow->v_tc_fl = ipv6_hdr->v_tc_fl;
+    flow->ports[0] = ports[0];
+    flow->ports[1] = ports[1];
+    flow->if_pid = netif_hdr->if_pid;
+    flow->nh = ipv6_hdr->nh;
+    flow->hl = ipv6_hdr->hl;
+    flow->src_l2addr_len = netif_hdr->src_l2addr_len;
+    flow->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    memcpy(flow->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    memcpy(flow->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    flow->driver_iid = false;
+    flow->hl_pos = 0;
+    flow->len = 0;
+
+    return flow;
+}
+#endif
+
+static inline void _replace_ipv6_hdr(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *dispatch,
+                                     size_t dispatch_len)
+{
+    /* shrink dispatch allocation to final size */
+    /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
+    gnrc_pktbuf_realloc_data(dispatch, dispatch_len);
+
+    /* remove IPv6 header */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+
+    /* insert dispatch into packet */
+    dispatch->next = pkt->next;
+    pkt->next = dispatch;
+}
+
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_hdr_t *netif_hdr = pkt->data;
@@ -592,6 +738,9 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
     gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
                                                GNRC_NETTYPE_SIXLOWPAN);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    _flow_t *flow;
+#endif
 
     if (dispatch == NULL) {
         DEBUG("6lo iphc: error allocating dispatch space\n");
@@ -600,6 +749,24 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
     iphc_hdr = dispatch->data;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    flow = _flow_get(netif_hdr, ipv6_hdr, pkt->next->next);
+    if ((flow != NULL) && (flow->len > 0)) {
+        DEBUG("6lo iphc: use compressed header of flow\n");
+        memcpy(iphc_hdr, flow->hdr, flow->len);
+        if (flow->hl_pos != 0) {
+            iphc_hdr[flow->hl_pos] = ipv6_hdr->hl;
+        }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+        if (ipv6_hdr->nh == PROTNUM_UDP) {
+            iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
+        }
+#endif
+        _replace_ipv6_hdr(pkt, dispatch, flow->len);
+        return true;
+    }
+#endif
+
     /* set initial dispatch value*/
     iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
     iphc_hdr[IPHC2_IDX] = 0;
@@ -691,6 +858,11 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
         default:
             iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+            if (flow != NULL) {
+                flow->hl_pos = (uint8_t)inline_pos;
+            }
+#endif
             iphc_hdr[inline_pos++] = ipv6_hdr->hl;
             break;
     }
@@ -723,6 +895,12 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
                 /* but take from driver otherwise */
                 gnrc_netapi_get(netif_hdr->if_pid, NETOPT_IPV6_IID, 0, &iid,
                                 sizeof(eui64_t));
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+                if (flow != NULL) {
+                    flow->driver_iid = true;
+                    flow->iid.uint64.u64 = iid.uint64.u64;
+                }
+#endif
             }
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
@@ -874,16 +1052,14 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
         iphc_hdr[inline_pos++] = ipv6_hdr->nh;
     }
 
-    /* shrink dispatch allocation to final size */
-    /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
-    gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
-
-    /* remove IPv6 header */
-    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    if (flow != NULL) {
+        memcpy(flow->hdr, iphc_hdr, inline_pos);
+        flow->len = (uint8_t)inline_pos;
+    }
+#endif
 
-    /* insert dispatch into packet */
-    dispatch->next = pkt->next;
-    pkt->next = dispatch;
+    _replace_ipv6_hdr(pkt, dispatch, (size_t)inline_pos);
 
     return true;
 }
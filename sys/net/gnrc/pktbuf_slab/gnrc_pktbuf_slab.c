@@ -0,0 +1,598 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation using segregated free lists of fixed
+ *          size chunks
+ *
+ * Every size class owns a static array of chunks and keeps its unused chunks
+ * in a singly linked free list, so allocating and freeing is independent of
+ * the number of packets in the buffer and the buffer can not fragment.
+ * gnrc_pktsnip_t::data may point anywhere into a chunk (e.g. after
+ * gnrc_pktbuf_mark()), the chunk is derived from the address on free.
+ *
+ * @author  agent <agent@local>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGN(size)        (((size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+#define _SNIP_SIZE          _ALIGN(sizeof(gnrc_pktsnip_t))
+#define _SMALL_SIZE         _ALIGN(GNRC_PKTBUF_SLAB_SMALL_SIZE)
+#define _MEDIUM_SIZE        _ALIGN(GNRC_PKTBUF_SLAB_MEDIUM_SIZE)
+#define _LARGE_SIZE         _ALIGN(GNRC_PKTBUF_SLAB_LARGE_SIZE)
+
+/**
+ * @brief   Index of the first class used for snip data
+ */
+#define _DATA_CLASS         (1U)
+
+typedef struct _chunk {
+    struct _chunk *next;
+} _chunk_t;
+
+typedef struct {
+    uint8_t *mem;           /**< first chunk of the class */
+    _chunk_t *free;         /**< free list */
+    uint16_t size;          /**< chunk size */
+    uint16_t numof;         /**< number of chunks */
+    uint16_t free_numof;    /**< number of chunks in the free list */
+#ifdef DEVELHELP
+    uint16_t max_used;      /**< maximum number of chunks in use */
+    uint32_t fails;         /**< allocations fitting this class that failed */
+    uint32_t fallbacks;     /**< allocations served by a larger class */
+    uint32_t bytes;         /**< bytes used in the chunks in use */
+#endif
+} _class_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+
+/* void * to have all chunks aligned */
+static void *_snip_mem[GNRC_PKTBUF_SLAB_SNIP_NUMOF * _SNIP_SIZE / sizeof(void *)];
+static void *_small_mem[GNRC_PKTBUF_SLAB_SMALL_NUMOF * _SMALL_SIZE / sizeof(void *)];
+static void *_medium_mem[GNRC_PKTBUF_SLAB_MEDIUM_NUMOF * _MEDIUM_SIZE / sizeof(void *)];
+static void *_large_mem[GNRC_PKTBUF_SLAB_LARGE_NUMOF * _LARGE_SIZE / sizeof(void *)];
+
+/* sorted by chunk size */
+static _class_t _classes[] = {
+    { .mem = (uint8_t *)_snip_mem, .size = _SNIP_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_SNIP_NUMOF },
+    { .mem = (uint8_t *)_small_mem, .size = _SMALL_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_SMALL_NUMOF },
+    { .mem = (uint8_t *)_medium_mem, .size = _MEDIUM_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_MEDIUM_NUMOF },
+    { .mem = (uint8_t *)_large_mem, .size = _LARGE_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_LARGE_NUMOF },
+};
+
+#define _CLASSES_NUMOF      (sizeof(_classes) / sizeof(_classes[0]))
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size, unsigned first);
+static void _pktbuf_free(void *data, size_t size);
+
+static inline bool _class_contains(const _class_t *c, const void *ptr)
+{
+    return (size_t)((uint8_t *)ptr - c->mem) < ((size_t)c->size * c->numof);
+}
+
+static _class_t *_class_of(const void *ptr)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        if (_class_contains(&_classes[i], ptr)) {
+            return &_classes[i];
+        }
+    }
+    return NULL;
+}
+
+/* first byte behind the chunk @p ptr points into */
+static inline uint8_t *_chunk_end(const _class_t *c, const void *ptr)
+{
+    size_t offset = (uint8_t *)ptr - c->mem;
+
+    return c->mem + (offset - (offset % c->size)) + c->size;
+}
+
+static inline void _account(_class_t *c, int delta)
+{
+#ifdef DEVELHELP
+    c->bytes += delta;
+#else
+    (void)c;
+    (void)delta;
+#endif
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *c = &_classes[i];
+
+        assert((i == 0) || (_classes[i - 1].size <= c->size));
+        c->free = NULL;
+        /* build the free list back to front, so the first chunk is on top */
+        for (unsigned j = c->numof; j > 0; j--) {
+            _chunk_t *chunk = (_chunk_t *)(c->mem + ((j - 1) * c->size));
+
+            chunk->next = c->free;
+            c->free = chunk;
+        }
+        c->free_numof = c->numof;
+#ifdef DEVELHELP
+        c->max_used = 0;
+        c->fails = 0;
+        c->fallbacks = 0;
+        c->bytes = 0;
+#endif
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if ((size == 0) || (size > _LARGE_SIZE)) {
+        DEBUG("pktbuf: size (%u) == 0 || size > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, (unsigned)_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data;
+    size_t rest;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    else if (size == pkt->size) {
+        pkt->type = type;
+        mutex_unlock(&_mutex);
+        return pkt;
+    }
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t), 0);
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    rest = pkt->size - size;
+    /* a chunk can not be split, so copy the smaller part to a new chunk */
+    new_data = _pktbuf_alloc((size <= rest) ? size : rest, _DATA_CLASS);
+    if (new_data == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (size <= rest) {
+        memcpy(new_data, pkt->data, size);
+        _set_pktsnip(marked_snip, pkt->next, new_data, size, type);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+        _account(_class_of(pkt->data), -((int)size));
+    }
+    else {
+        memcpy(new_data, ((uint8_t *)pkt->data) + size, rest);
+        _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type);
+        pkt->data = new_data;
+        _account(_class_of(marked_snip->data), -((int)rest));
+    }
+    pkt->size = rest;
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    _class_t *c, *fit = NULL;
+
+    mutex_lock(&_mutex);
+    assert((pkt != NULL) && (pkt->data != NULL) && (_class_of(pkt->data) != NULL));
+    if (size == 0) {
+        DEBUG("pktbuf: size == 0\n");
+        mutex_unlock(&_mutex);
+        return ENOMEM;
+    }
+    if (size == pkt->size) {
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    c = _class_of(pkt->data);
+    for (unsigned i = _DATA_CLASS; i < _CLASSES_NUMOF; i++) {
+        if (size <= _classes[i].size) {
+            fit = &_classes[i];
+            break;
+        }
+    }
+    if ((size > (size_t)(_chunk_end(c, pkt->data) - (uint8_t *)pkt->data)) ||
+        ((fit != NULL) && (fit < c) && (fit->free != NULL))) {
+        /* does not fit into the chunk or would fit into a smaller one */
+        void *new_data = _pktbuf_alloc(size, _DATA_CLASS);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    else {
+        _account(c, (int)size - (int)pkt->size);
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_class_of(pkt) != NULL);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data, pkt->size);
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
+{
+    size_t length;
+    gnrc_pktsnip_t *head;
+    struct iovec *vec;
+
+    if (pkt == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    /* count the number of snips in the packet and allocate the IOVEC */
+    length = gnrc_pkt_count(pkt);
+    head = gnrc_pktbuf_add(pkt, NULL, (length * sizeof(struct iovec)),
+                           GNRC_NETTYPE_IOVEC);
+    if (head == NULL) {
+        *len = 0;
+        return NULL;
+    }
+    vec = (struct iovec *)(head->data);
+    /* fill the IOVEC */
+    while (pkt != NULL) {
+        vec->iov_base = pkt->data;
+        vec->iov_len = pkt->size;
+        ++vec;
+        pkt = pkt->next;
+    }
+    *len = length;
+    return head;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    uint32_t fails = 0;
+
+    mutex_lock(&_mutex);
+    puts("packet buffer size classes:");
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *c = &_classes[i];
+        unsigned used = c->numof - c->free_numof;
+
+        printf("  %4u byte%s: %3u/%3u used (max: %3u), failed: %4" PRIu32
+               ", fallbacks: %4" PRIu32 ", unused bytes in use: %5" PRIu32 "\n",
+               c->size, (i == 0) ? " snip" : "     ", used, c->numof, c->max_used,
+               c->fails, c->fallbacks, ((uint32_t)used * c->size) - c->bytes);
+        fails += c->fails;
+    }
+    printf("  failed allocations: %" PRIu32 "\n", fails);
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        if (_classes[i].free_numof != _classes[i].numof) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall chunks in a class' free list: chunk is the start of a chunk
+     *    of the class
+     *  - the free list of a class has free_numof <= numof elements
+     */
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *c = &_classes[i];
+        unsigned count = 0;
+
+        for (_chunk_t *ptr = c->free; ptr != NULL; ptr = ptr->next) {
+            if (!_class_contains(c, ptr) ||
+                ((((uint8_t *)ptr) - c->mem) % c->size) != 0 ||
+                (++count > c->numof)) {
+                return false;
+            }
+        }
+        if ((count != c->free_numof) || (count > c->numof)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t), 0);
+    void *_data;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    _data = _pktbuf_alloc(size, _DATA_CLASS);
+    if (_data == NULL) {
+        DEBUG("pktbuf: error allocating data for new packet snip\n");
+        _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        return NULL;
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size, unsigned first)
+{
+    unsigned i = first;
+
+    /* find the smallest fitting class ... */
+    while ((i < _CLASSES_NUMOF) && (size > _classes[i].size)) {
+        i++;
+    }
+    if (i == _CLASSES_NUMOF) {
+        DEBUG("pktbuf: %u byte do not fit into any chunk\n", (unsigned)size);
+        return NULL;
+    }
+#ifdef DEVELHELP
+    _class_t *fit = &_classes[i];
+#endif
+    /* ... and fall back to larger ones if it is exhausted */
+    while ((i < _CLASSES_NUMOF) && (_classes[i].free == NULL)) {
+        i++;
+    }
+    if (i == _CLASSES_NUMOF) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+#ifdef DEVELHELP
+        fit->fails++;
+#endif
+        return NULL;
+    }
+
+    _class_t *c = &_classes[i];
+    _chunk_t *chunk = c->free;
+
+    c->free = chunk->next;
+    c->free_numof--;
+#ifdef DEVELHELP
+    if (c != fit) {
+        fit->fallbacks++;
+    }
+    if ((c->numof - c->free_numof) > c->max_used) {
+        c->max_used = c->numof - c->free_numof;
+    }
+#endif
+    _account(c, size);
+    return chunk;
+}
+
+static void _pktbuf_free(void *data, size_t size)
+{
+    _class_t *c = _class_of(data);
+    _chunk_t *chunk;
+
+    if (c == NULL) {
+        return;
+    }
+    /* data may point into the chunk */
+    chunk = (_chunk_t *)(_chunk_end(c, data) - c->size);
+    chunk->next = c->free;
+    c->free = chunk;
+    c->free_numof++;
+    _account(c, -((int)size));
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *snip)
+{
+    LL_DELETE(pkt, snip);
+    snip->next = NULL;
+    gnrc_pktbuf_release(snip);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *old, gnrc_pktsnip_t *add)
+{
+    /* If add is a list we need to preserve its tail */
+    if (add->next != NULL) {
+        gnrc_pktsnip_t *tail = add->next;
+        gnrc_pktsnip_t *back;
+        LL_SEARCH_SCALAR(tail, back, next, NULL); /* find the last snip in add */
+        /* Replace old */
+        LL_REPLACE_ELEM(pkt, old, add);
+        /* and wire in the tail between */
+        back->next = add->next;
+        add->next = tail;
+    }
+    else {
+        /* add is a single element, has no tail, simply replace */
+        LL_REPLACE_ELEM(pkt, old, add);
+    }
+    old->next = NULL;
+    gnrc_pktbuf_release(old);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
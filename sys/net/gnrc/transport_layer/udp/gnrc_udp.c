@@ -17,6 +17,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <errno.h>
 
@@ -27,6 +28,9 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netapi/direct.h"
+#endif
 #include "net/inet_csum.h"
 
 
@@ -38,6 +42,7 @@
  */
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 /**
  * @brief   Allocate memory for the UDP thread's stack
  */
@@ -46,6 +51,7 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
+#endif
 
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
@@ -209,16 +215,39 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+static bool _handle_msg(msg_t *msg)
+{
+    msg_t reply;
+
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+            _receive((gnrc_pktsnip_t *)msg->content.ptr);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+            _send((gnrc_pktsnip_t *)msg->content.ptr);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SET:
+        case GNRC_NETAPI_MSG_TYPE_GET:
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = (uint32_t)-ENOTSUP;
+            msg_reply(msg, &reply);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 static void *_event_loop(void *arg)
 {
     (void)arg;
-    msg_t msg, reply;
+    msg_t msg;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
     gnrc_netreg_entry_t netreg;
 
-    /* preset reply message */
-    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-    reply.content.value = (uint32_t)-ENOTSUP;
     /* initialize message queue */
     msg_init_queue(msg_queue, GNRC_UDP_MSG_QUEUE_SIZE);
     /* register UPD at netreg */
@@ -229,28 +258,15 @@ static void *_event_loop(void *arg)
     /* dispatch NETAPI messages */
     while (1) {
         msg_receive(&msg);
-        switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
-                _receive((gnrc_pktsnip_t *)msg.content.ptr);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
-                _send((gnrc_pktsnip_t *)msg.content.ptr);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SET:
-            case GNRC_NETAPI_MSG_TYPE_GET:
-                msg_reply(&msg, &reply);
-                break;
-            default:
-                DEBUG("udp: received unidentified message\n");
-                break;
+        if (!_handle_msg(&msg)) {
+            DEBUG("udp: received unidentified message\n");
         }
     }
 
     /* never reached */
     return NULL;
 }
+#endif
 
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
@@ -294,9 +310,14 @@ int gnrc_udp_init(void)
 {
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+        /* share the stack thread */
+        _pid = gnrc_netapi_direct_register(GNRC_NETTYPE_UDP, _handle_msg);
+#else
         /* start UDP thread */
         _pid = thread_create(_stack, sizeof(_stack), GNRC_UDP_PRIO,
                              THREAD_CREATE_STACKTEST, _event_loop, NULL, "udp");
+#endif
     }
     return _pid;
 }
@@ -24,6 +24,7 @@
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include "assert.h"
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -64,6 +65,345 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now64() + (ms * 1000);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief returns the bit at position @p pos of @p key, counted from the MSB
+ */
+static inline unsigned fib_trie_bit(const uint8_t *key, unsigned pos)
+{
+    return (key[pos >> 3] >> (7 - (pos & 7))) & 0x01;
+}
+
+/**
+ * @brief returns the number of equal leading bits of @p a and @p b
+ *
+ * @param[in] a     the first key
+ * @param[in] b     the second key
+ * @param[in] from  number of leading bits known to be equal
+ * @param[in] max   maximum number of bits to compare
+ */
+static unsigned fib_trie_common(const uint8_t *a, const uint8_t *b,
+                                unsigned from, unsigned max)
+{
+    unsigned i = from;
+
+    while (i < max) {
+        if (((i & 7) == 0) && ((i + 8) <= max) && (a[i >> 3] == b[i >> 3])) {
+            i += 8;
+            continue;
+        }
+        if (fib_trie_bit(a, i) != fib_trie_bit(b, i)) {
+            break;
+        }
+        i++;
+    }
+
+    return i;
+}
+
+/**
+ * @brief builds the trie key for an address, i.e. its size followed by the
+ *        address itself
+ *
+ * @return the number of bits of the key
+ */
+static unsigned fib_trie_make_key(uint8_t *key, uint8_t *addr, size_t addr_size)
+{
+    memset(key, 0, UNIVERSAL_ADDRESS_SIZE + 1);
+    key[0] = (uint8_t)addr_size;
+    memcpy(&key[1], addr, addr_size);
+    return (addr_size + 1) << 3;
+}
+
+/**
+ * @brief builds the trie key for a FIB entry
+ *
+ * Entries with an all-zero address are default routes (prefix length 0),
+ * entries without FIB_FLAG_NET_PREFIX_MASK only match their exact address.
+ *
+ * @return the number of significant bits of the key
+ */
+static unsigned fib_trie_entry_key(fib_entry_t *entry, uint8_t *key)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned len = fib_trie_make_key(key, global->address, global->address_size);
+    unsigned prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                          >> FIB_FLAG_NET_PREFIX_SHIFT;
+    bool is_all_zeros_addr = true;
+
+    for (size_t i = 0; i < global->address_size; ++i) {
+        if (global->address[i] != 0) {
+            is_all_zeros_addr = false;
+            break;
+        }
+    }
+
+    if (is_all_zeros_addr) {
+        return 8;
+    }
+    if ((prefix_len != 0) && ((prefix_len + 8) < len)) {
+        return prefix_len + 8;
+    }
+    return len;
+}
+
+static fib_trie_node_t *fib_trie_alloc(fib_table_t *table)
+{
+    fib_trie_node_t *node = table->trie_free;
+
+    if (node != NULL) {
+        table->trie_free = node->child[0];
+        memset(node, 0, sizeof(fib_trie_node_t));
+    }
+
+    return node;
+}
+
+static void fib_trie_release(fib_table_t *table, fib_trie_node_t *node)
+{
+    node->len = 0;
+    node->entry = NULL;
+    node->child[0] = table->trie_free;
+    table->trie_free = node;
+}
+
+/**
+ * @brief resets the prefix trie of @p table to an empty trie
+ */
+static void fib_trie_init(fib_table_t *table)
+{
+    if (table->table_type != FIB_TABLE_TYPE_SH) {
+        return;
+    }
+
+    assert(table->trie_nodes != NULL);
+    table->trie_root = NULL;
+    table->trie_free = NULL;
+    for (size_t i = 0; i < FIB_TRIE_NODES_NUMOF(table->size); ++i) {
+        fib_trie_release(table, &table->trie_nodes[i]);
+    }
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+}
+
+/**
+ * @brief adds the (valid) @p entry to the prefix trie of @p table
+ *
+ * @return 0 on success
+ *         -ENOMEM if the node pool is exhausted
+ */
+static int fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE + 1];
+    unsigned len = fib_trie_entry_key(entry, key);
+    unsigned common = 0;
+    fib_trie_node_t *parent = NULL;
+    fib_trie_node_t **link = &table->trie_root;
+    fib_trie_node_t *node = fib_trie_alloc(table);
+
+    if (node == NULL) {
+        return -ENOMEM;
+    }
+
+    node->entry = entry;
+    node->len = len;
+    memcpy(node->key, key, sizeof(key));
+
+    while (*link != NULL) {
+        fib_trie_node_t *cur = *link;
+
+        common = fib_trie_common(cur->key, key, common,
+                                 (cur->len < len) ? cur->len : len);
+
+        if (common < cur->len) {
+            /* cur moves below the new node or below a new branching node */
+            if (common < len) {
+                fib_trie_node_t *branch = fib_trie_alloc(table);
+
+                if (branch == NULL) {
+                    fib_trie_release(table, node);
+                    return -ENOMEM;
+                }
+
+                branch->len = common;
+                memcpy(branch->key, key, sizeof(key));
+                branch->child[fib_trie_bit(key, common)] = node;
+                node->parent = branch;
+                node = branch;
+            }
+            node->child[fib_trie_bit(cur->key, common)] = cur;
+            cur->parent = node;
+            break;
+        }
+
+        if (cur->len == len) {
+            if (cur->entry == NULL) {
+                /* a branching node gets the entry */
+                cur->entry = entry;
+                fib_trie_release(table, node);
+            }
+            else {
+                node->same = cur->same;
+                cur->same = node;
+            }
+            return 0;
+        }
+
+        parent = cur;
+        link = &cur->child[fib_trie_bit(key, cur->len)];
+    }
+
+    node->parent = parent;
+    *link = node;
+    return 0;
+}
+
+/**
+ * @brief removes @p entry from the prefix trie of @p table
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE + 1];
+    unsigned len = fib_trie_entry_key(entry, key);
+    unsigned common = 0;
+    fib_trie_node_t *node = table->trie_root;
+
+    while ((node != NULL) && (node->len <= len)) {
+        common = fib_trie_common(node->key, key, common, node->len);
+        if ((common < node->len) || (node->len == len)) {
+            break;
+        }
+        node = node->child[fib_trie_bit(key, node->len)];
+    }
+
+    if ((node == NULL) || (node->len != len) || (common < len)) {
+        return;
+    }
+
+    if (node->entry != entry) {
+        for (fib_trie_node_t *prev = node; prev->same != NULL; prev = prev->same) {
+            if (prev->same->entry == entry) {
+                fib_trie_node_t *same = prev->same;
+                prev->same = same->same;
+                fib_trie_release(table, same);
+                return;
+            }
+        }
+        return;
+    }
+
+    if (node->same != NULL) {
+        fib_trie_node_t *same = node->same;
+        node->entry = same->entry;
+        node->same = same->same;
+        fib_trie_release(table, same);
+        return;
+    }
+
+    node->entry = NULL;
+
+    /* drop nodes that are neither entries nor branches anymore */
+    while ((node != NULL) && (node->entry == NULL) &&
+           ((node->child[0] == NULL) || (node->child[1] == NULL))) {
+        fib_trie_node_t *child = (node->child[0] != NULL) ? node->child[0]
+                                                          : node->child[1];
+        fib_trie_node_t *parent = node->parent;
+
+        if (parent == NULL) {
+            table->trie_root = child;
+        }
+        else {
+            parent->child[parent->child[1] == node] = child;
+        }
+        if (child != NULL) {
+            child->parent = parent;
+        }
+        fib_trie_release(table, node);
+        node = (child == NULL) ? parent : NULL;
+    }
+}
+
+/**
+ * @brief removes all expired entries once the earliest lifetime passed
+ */
+static void fib_expire(fib_table_t *table)
+{
+    uint64_t now = xtimer_now64();
+
+    if (now <= table->next_expiry) {
+        return;
+    }
+
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry->lifetime == 0) || (entry->lifetime == FIB_LIFETIME_NO_EXPIRE)) {
+            continue;
+        }
+        if (entry->lifetime < now) {
+            fib_remove(table, entry);
+        }
+        else if (entry->lifetime < table->next_expiry) {
+            table->next_expiry = entry->lifetime;
+        }
+    }
+}
+
+/**
+ * @brief looks up the longest matching prefix for @p dst in the prefix trie
+ *
+ * @see fib_find_entry()
+ */
+static int fib_trie_find(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                         fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE + 1];
+    unsigned len, common = 0;
+    fib_trie_node_t *node = table->trie_root;
+    fib_entry_t *best = NULL;
+
+    *entry_arr_size = 0;
+    if (dst_size > UNIVERSAL_ADDRESS_SIZE) {
+        return -EHOSTUNREACH;
+    }
+
+    len = fib_trie_make_key(key, dst, dst_size);
+
+    while ((node != NULL) && (node->len <= len)) {
+        common = fib_trie_common(node->key, key, common, node->len);
+        if (common < node->len) {
+            break;
+        }
+
+        if (node->entry != NULL) {
+            for (fib_trie_node_t *n = node; n != NULL; n = n->same) {
+                if (memcmp(n->entry->global->address, dst, dst_size) == 0) {
+                    entry_arr[0] = n->entry;
+                    *entry_arr_size = 1;
+                    return 1;
+                }
+            }
+            best = node->entry;
+        }
+
+        if (node->len == len) {
+            break;
+        }
+        node = node->child[fib_trie_bit(key, node->len)];
+    }
+
+    if (best == NULL) {
+        return -EHOSTUNREACH;
+    }
+
+    entry_arr[0] = best;
+    *entry_arr_size = 1;
+    return 0;
+}
+#endif
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -80,6 +420,10 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
+#ifdef MODULE_FIB_TRIE
+    fib_expire(table);
+    return fib_trie_find(table, dst, dst_size, entry_arr, entry_arr_size);
+#else
     uint64_t now = xtimer_now64();
 
     size_t count = 0;
@@ -119,6 +463,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                 if (table->data.entries[i].global != NULL) {
                     universal_address_rem(table->data.entries[i].global);
                     table->data.entries[i].global = NULL;
+                    table->generation++;
                 }
 
                 if (table->data.entries[i].next_hop != NULL) {
@@ -186,6 +531,25 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     *entry_arr_size = count;
     return ret;
+#endif
+}
+
+/**
+ * @brief keeps track of the earliest lifetime of all entries in @p table
+ *
+ * @param[in] table     the FIB table the entry belongs to
+ * @param[in] entry     the entry which lifetime was set
+ */
+static inline void fib_track_lifetime(fib_table_t *table, fib_entry_t *entry)
+{
+#ifdef MODULE_FIB_TRIE
+    if (entry->lifetime < table->next_expiry) {
+        table->next_expiry = entry->lifetime;
+    }
+#else
+    (void)table;
+    (void)entry;
+#endif
 }
 
 /**
@@ -267,6 +631,15 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+#ifdef MODULE_FIB_TRIE
+                if (fib_trie_insert(table, &table->data.entries[i]) != 0) {
+                    fib_remove(table, &table->data.entries[i]);
+                    return -ENOMEM;
+                }
+#endif
+                fib_track_lifetime(table, &table->data.entries[i]);
+                table->generation++;
+
                 return 0;
             }
         }
@@ -278,12 +651,19 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+#ifdef MODULE_FIB_TRIE
+    if ((entry->global != NULL) && (entry->lifetime != 0)) {
+        fib_trie_remove(table, entry);
+    }
+#endif
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -299,6 +679,7 @@ static int fib_remove(fib_entry_t *entry)
 
     entry->iface_id = KERNEL_PID_UNDEF;
     entry->lifetime = 0;
+    table->generation++;
 
     return 0;
 }
@@ -403,6 +784,8 @@ int fib_add_entry(fib_table_t *table,
     if (ret == 1) {
         /* we must take the according entry and update the values */
         ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        fib_track_lifetime(table, entry[0]);
+        table->generation++;
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,6 +816,8 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
         ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        fib_track_lifetime(table, entry[0]);
+        table->generation++;
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -456,7 +841,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -476,7 +861,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -586,6 +971,7 @@ void fib_init(fib_table_t *table)
     }
 
     table->notify_rp_pos = 0;
+    table->generation++;
 
     if (table->table_type == FIB_TABLE_TYPE_SR) {
         memset(table->data.source_routes->headers, 0,
@@ -596,6 +982,9 @@ void fib_init(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+#ifdef MODULE_FIB_TRIE
+    fib_trie_init(table);
+#endif
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -611,6 +1000,7 @@ void fib_deinit(fib_table_t *table)
     }
 
     table->notify_rp_pos = 0;
+    table->generation++;
 
     if (table->table_type == FIB_TABLE_TYPE_SR) {
         memset(table->data.source_routes->headers, 0,
@@ -621,6 +1011,9 @@ void fib_deinit(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+#ifdef MODULE_FIB_TRIE
+    fib_trie_init(table);
+#endif
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
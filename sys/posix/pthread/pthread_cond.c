@@ -128,6 +128,7 @@ int pthread_cond_timedwait(pthread_cond_t *cond, mutex_t *mutex, const struct ti
     reltime = timex_sub(then, now);
 
     xtimer_t timer;
+    timer.target = timer.long_target = 0;
     xtimer_set_wakeup64(&timer, timex_uint64(reltime) , sched_active_pid);
     int result = pthread_cond_wait(cond, mutex);
     xtimer_remove(&timer);
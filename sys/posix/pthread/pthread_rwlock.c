@@ -200,6 +200,7 @@ static int pthread_rwlock_timedlock(pthread_rwlock_t *rwlock,
         timex_t reltime = timex_sub(then, now);
 
         xtimer_t timer;
+        timer.target = timer.long_target = 0;
         xtimer_set_wakeup64(&timer, timex_uint64(reltime) , sched_active_pid);
         int result = pthread_rwlock_lock(rwlock, is_blocked, is_writer, incr_when_held, true);
         if (result != ETIMEDOUT) {
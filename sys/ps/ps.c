@@ -16,6 +16,7 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "thread.h"
 #include "sched.h"
@@ -58,6 +59,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime | switches"
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+           "| msg queued   direct  dropped  blocked |   hwm"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -81,6 +85,9 @@ void ps(void)
 #ifdef MODULE_SCHEDSTATISTICS
             double runtime_ticks =  sched_pidlist[i].runtime_ticks / (double) xtimer_now() * 100;
             int switches = sched_pidlist[i].schedules;
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+            msg_stats_t *msg_stats = &p->msg_stats;
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -92,6 +99,10 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %6.3f%% |  %8d"
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+                   " | %10" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32
+                   " | %5u"
 #endif
                    "\n",
                    p->pid,
@@ -104,6 +115,10 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_ticks, switches
+#endif
+#ifdef MODULE_CORE_MSG_STATS
+                   , msg_stats->queued, msg_stats->direct, msg_stats->dropped,
+                   msg_stats->send_blocked, (unsigned)msg_stats->queue_hwm
 #endif
                   );
         }
@@ -37,6 +37,10 @@ extern int _heap_handler(int argc, char **argv);
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_TRACE
+extern int _trace_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT11
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -140,6 +144,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
+#ifdef MODULE_TRACE
+    {"trace", "Controls the kernel event tracer ('trace [start|stop|clear|dump]')", _trace_handler},
+#endif
 #ifdef MODULE_SHT11
     {"temp", "Prints measured temperature.", _get_temperature_handler},
     {"hum", "Prints measured humidity.", _get_humidity_handler},
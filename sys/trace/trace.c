@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_trace
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracer implementation
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+#include "trace.h"
+#include "xtimer.h"
+
+#if (TRACE_BUFSIZE & (TRACE_BUFSIZE - 1)) != 0
+#error "TRACE_BUFSIZE must be a power of two"
+#endif
+
+static trace_event_t _events[TRACE_BUFSIZE];
+static uint32_t _total;
+static volatile uint8_t _enabled;
+
+void trace_start(void)
+{
+    _enabled = 1;
+}
+
+void trace_stop(void)
+{
+    _enabled = 0;
+}
+
+void trace_clear(void)
+{
+    unsigned state = irq_disable();
+    _total = 0;
+    irq_restore(state);
+}
+
+void trace_event(trace_type_t type, uint32_t arg)
+{
+    if (!_enabled) {
+        return;
+    }
+
+    unsigned state = irq_disable();
+    trace_event_t *event = &_events[_total++ & (TRACE_BUFSIZE - 1)];
+
+    event->time = xtimer_now();
+    event->arg = arg;
+    event->pid = sched_active_pid;
+    event->type = type;
+    irq_restore(state);
+}
+
+unsigned trace_read(trace_event_t *events, unsigned numof)
+{
+    unsigned state = irq_disable();
+    uint32_t first = (_total > TRACE_BUFSIZE) ? (_total - TRACE_BUFSIZE) : 0;
+    unsigned count = 0;
+
+    if ((_total - first) < numof) {
+        numof = _total - first;
+    }
+    while (count < numof) {
+        events[count++] = _events[first++ & (TRACE_BUFSIZE - 1)];
+    }
+    irq_restore(state);
+
+    return count;
+}
+
+uint32_t trace_total(void)
+{
+    return _total;
+}
+
+void trace_dump(void)
+{
+    uint8_t enabled = _enabled;
+    uint32_t first;
+
+    _enabled = 0;
+    first = (_total > TRACE_BUFSIZE) ? (_total - TRACE_BUFSIZE) : 0;
+
+    printf("trace: %" PRIu32 " events, %" PRIu32 " overwritten\n",
+           _total - first, first);
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        thread_t *thread = (thread_t *)sched_threads[pid];
+
+        if (thread != NULL) {
+#ifdef DEVELHELP
+            printf("TRACE T %" PRIkernel_pid " %s\n", pid, thread->name);
+#else
+            printf("TRACE T %" PRIkernel_pid " thread%" PRIkernel_pid "\n",
+                   pid, pid);
+#endif
+        }
+    }
+    /* time pid type arg */
+    for (; first != _total; first++) {
+        trace_event_t *event = &_events[first & (TRACE_BUFSIZE - 1)];
+
+        printf("TRACE E %" PRIu32 " %" PRIkernel_pid " %u %" PRIx32 "\n",
+               event->time, event->pid, (unsigned)event->type, event->arg);
+    }
+
+    _enabled = enabled;
+}
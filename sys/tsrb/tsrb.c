@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, char c)
@@ -29,6 +31,26 @@ static char _pop(tsrb_t *rb)
     return rb->buf[rb->reads++ & (rb->size - 1)];
 }
 
+/* splits n bytes starting at counter value pos into up to two regions */
+static void _split(const tsrb_t *rb, unsigned pos, unsigned n,
+                   tsrb_span_t span[2])
+{
+    unsigned till_end;
+
+    pos &= (rb->size - 1);
+    till_end = rb->size - pos;
+    span[0].buf = rb->buf + pos;
+    span[1].buf = rb->buf;
+    if (n <= till_end) {
+        span[0].len = n;
+        span[1].len = 0;
+    }
+    else {
+        span[0].len = till_end;
+        span[1].len = n - till_end;
+    }
+}
+
 int tsrb_get_one(tsrb_t *rb)
 {
     if (!tsrb_empty(rb)) {
@@ -41,12 +63,22 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    tsrb_span_t span[2];
+    unsigned avail = tsrb_peek_span(rb, span);
+
+    if (n > avail) {
+        n = avail;
+    }
+    if (n <= span[0].len) {
+        memcpy(dst, span[0].buf, n);
+    }
+    else {
+        memcpy(dst, span[0].buf, span[0].len);
+        memcpy(dst + span[0].len, span[1].buf, n - span[0].len);
     }
-    return (n - tmp);
+    /* only give the space back once the data was copied */
+    rb->reads += n;
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -62,10 +94,55 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    tsrb_span_t span[2];
+    unsigned free = tsrb_write_span(rb, span);
+
+    if (n > free) {
+        n = free;
+    }
+    if (n <= span[0].len) {
+        memcpy(span[0].buf, src, n);
+    }
+    else {
+        memcpy(span[0].buf, src, span[0].len);
+        memcpy(span[1].buf, src + span[0].len, n - span[0].len);
+    }
+    /* only publish the data once it was copied */
+    rb->writes += n;
+    return n;
+}
+
+unsigned tsrb_peek_span(const tsrb_t *rb, tsrb_span_t span[2])
+{
+    unsigned reads = rb->reads;
+    unsigned avail = rb->writes - reads;
+
+    _split(rb, reads, avail, span);
+    return avail;
+}
+
+unsigned tsrb_drop(tsrb_t *rb, unsigned n)
+{
+    unsigned avail = tsrb_avail(rb);
+
+    if (n > avail) {
+        n = avail;
     }
-    return (n - tmp);
+    rb->reads += n;
+    return n;
+}
+
+unsigned tsrb_write_span(const tsrb_t *rb, tsrb_span_t span[2])
+{
+    unsigned writes = rb->writes;
+    unsigned free = rb->size - (writes - rb->reads);
+
+    _split(rb, writes, free, span);
+    return free;
+}
+
+void tsrb_commit(tsrb_t *rb, unsigned n)
+{
+    assert(n <= tsrb_free(rb));
+    rb->writes += n;
 }
@@ -26,6 +26,10 @@
 #endif
 #endif
 #include "mutex.h"
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+#include "bitfield.h"
+#include "hashes.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -61,6 +65,119 @@ static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_M
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+/**
+ * @brief Number of slots in the hash index
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_SLOTS
+#define UNIVERSAL_ADDRESS_HASH_SLOTS    (2 * UNIVERSAL_ADDRESS_MAX_ENTRIES)
+#endif
+
+#if UNIVERSAL_ADDRESS_HASH_SLOTS <= UNIVERSAL_ADDRESS_MAX_ENTRIES
+#error "UNIVERSAL_ADDRESS_HASH_SLOTS MUST BE > UNIVERSAL_ADDRESS_MAX_ENTRIES"
+#endif
+#if UNIVERSAL_ADDRESS_MAX_ENTRIES >= UINT16_MAX
+#error "UNIVERSAL_ADDRESS_MAX_ENTRIES MUST BE < UINT16_MAX"
+#endif
+
+/**
+ * @brief open addressing (linear probing) index of all containers holding an
+ *        address, by hash of the address. Slots store the container index + 1,
+ *        0 marks an empty slot.
+ */
+static uint16_t universal_address_index[UNIVERSAL_ADDRESS_HASH_SLOTS];
+
+/**
+ * @brief index of the first container not handed out since the last
+ *        init/reset
+ */
+static size_t universal_address_fresh = 0;
+
+/**
+ * @brief stack of container indices that became unused, the containers may
+ *        have been revived in the meantime.
+ */
+static uint16_t universal_address_unused[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+/**
+ * @brief number of elements in universal_address_unused
+ */
+static size_t universal_address_unused_num = 0;
+
+/**
+ * @brief marks the containers currently in universal_address_unused
+ */
+static BITFIELD(universal_address_is_unused, UNIVERSAL_ADDRESS_MAX_ENTRIES);
+
+static size_t universal_address_hash(const uint8_t *addr, size_t addr_size)
+{
+    return (one_at_a_time_hash(addr, addr_size) ^ addr_size) % UNIVERSAL_ADDRESS_HASH_SLOTS;
+}
+
+/**
+ * @brief returns the slot in the hash index pointing to the container
+ *        holding the given address, or the empty slot to insert it
+ */
+static size_t universal_address_index_find(const uint8_t *addr, size_t addr_size)
+{
+    size_t slot = universal_address_hash(addr, addr_size);
+
+    while (universal_address_index[slot] != 0) {
+        universal_address_container_t *entry =
+            &universal_address_table[universal_address_index[slot] - 1];
+
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            break;
+        }
+        slot = (slot + 1) % UNIVERSAL_ADDRESS_HASH_SLOTS;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief removes the container from the hash index (if it is indexed)
+ */
+static void universal_address_index_remove(universal_address_container_t *entry)
+{
+    size_t slot = universal_address_index_find(entry->address, entry->address_size);
+
+    if (universal_address_index[slot] == 0) {
+        return;
+    }
+
+    /* shift following entries of the probe sequence back into the hole */
+    size_t hole = slot;
+    universal_address_index[hole] = 0;
+    for (slot = (hole + 1) % UNIVERSAL_ADDRESS_HASH_SLOTS;
+         universal_address_index[slot] != 0;
+         slot = (slot + 1) % UNIVERSAL_ADDRESS_HASH_SLOTS) {
+        universal_address_container_t *moved =
+            &universal_address_table[universal_address_index[slot] - 1];
+        size_t home = universal_address_hash(moved->address, moved->address_size);
+
+        /* move it only if its home slot is not in (hole, slot] */
+        if ((hole < slot) ? ((home <= hole) || (home > slot))
+                          : ((home <= hole) && (home > slot))) {
+            universal_address_index[hole] = universal_address_index[slot];
+            universal_address_index[slot] = 0;
+            hole = slot;
+        }
+    }
+}
+
+/**
+ * @brief marks all containers unused
+ */
+static void universal_address_unused_reset(void)
+{
+    memset(universal_address_is_unused, 0, sizeof(universal_address_is_unused));
+    universal_address_unused_num = 0;
+    universal_address_fresh = 0;
+}
+#endif
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,6 +189,11 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    uint16_t idx = universal_address_index[universal_address_index_find(addr, addr_size)];
+
+    return (idx != 0) ? &(universal_address_table[idx - 1]) : NULL;
+#else
     for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
         if (universal_address_table[i].address_size == addr_size) {
             if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
@@ -81,6 +203,7 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
     }
 
     return NULL;
+#endif
 }
 
 /**
@@ -91,6 +214,28 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
 {
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    while (universal_address_unused_num > 0) {
+        size_t i = universal_address_unused[--universal_address_unused_num];
+
+        bf_unset(universal_address_is_unused, i);
+        /* skip containers revived after they became unused */
+        if (universal_address_table[i].use_count == 0) {
+            return &(universal_address_table[i]);
+        }
+    }
+
+    /* containers not handed out since the last init/reset */
+    while (universal_address_fresh < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
+        size_t i = universal_address_fresh++;
+
+        if (universal_address_table[i].use_count == 0) {
+            return &(universal_address_table[i]);
+        }
+    }
+
+    return NULL;
+#else
     if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
         for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
             if (universal_address_table[i].use_count == 0) {
@@ -100,6 +245,7 @@ static universal_address_container_t *universal_address_get_next_unused_entry(vo
     }
 
     return NULL;
+#endif
 }
 
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
@@ -117,6 +263,11 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        /* the container forgets its former address */
+        universal_address_index_remove(pEntry);
+#endif
+
         /* look if the former memory has distinct size */
         if (pEntry->address_size != addr_size) {
             /* clean the address */
@@ -129,6 +280,11 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        universal_address_index[universal_address_index_find(addr, addr_size)] =
+            (pEntry - universal_address_table) + 1;
+#endif
     }
 
     pEntry->use_count++;
@@ -155,6 +311,13 @@ void universal_address_rem(universal_address_container_t *entry)
 
             if (entry->use_count == 0) {
                 universal_address_table_filled--;
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+                size_t i = entry - universal_address_table;
+                if (!bf_isset(universal_address_is_unused, i)) {
+                    bf_set(universal_address_is_unused, i);
+                    universal_address_unused[universal_address_unused_num++] = i;
+                }
+#endif
             }
         }
         else {
@@ -300,6 +463,11 @@ void universal_address_init(void)
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    memset(universal_address_index, 0, sizeof(universal_address_index));
+    universal_address_unused_reset();
+#endif
+
     mutex_unlock(&mtx_access);
 }
 
@@ -311,6 +479,11 @@ void universal_address_reset(void)
         universal_address_table[i].use_count = 0;
     }
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    /* addresses are kept, so the index stays valid */
+    universal_address_unused_reset();
+#endif
+
     universal_address_table_filled = 0;
     mutex_unlock(&mtx_access);
 }
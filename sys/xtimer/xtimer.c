@@ -60,6 +60,7 @@ void xtimer_usleep_until(uint32_t *last_wakeup, uint32_t interval) {
 
     timer.callback = _callback_unlock_mutex;
     timer.arg = (void*) &mutex;
+    timer.target = timer.long_target = 0;
 
     uint32_t target = *last_wakeup + interval;
 
@@ -104,6 +105,56 @@ out:
     *last_wakeup = target;
 }
 
+int xtimer_set_absolute64(xtimer_t *timer, uint64_t target)
+{
+    unsigned state = irq_disable();
+    uint64_t now = xtimer_now64();
+
+    if (target <= now + (XTIMER_BACKOFF * 2)) {
+        irq_restore(state);
+        if (target > now) {
+            xtimer_spin((uint32_t)(target - now));
+        }
+        return 1;
+    }
+
+    uint64_t offset = target - now;
+    if (offset >> 32) {
+        _xtimer_set64(timer, (uint32_t)offset, offset >> 32);
+    }
+    else {
+        /* with interrupts disabled the target can not pass before it is
+         * set, so the lower 32 bit are unambiguous */
+        _xtimer_set_absolute(timer, (uint32_t)target);
+    }
+    irq_restore(state);
+    return 0;
+}
+
+void xtimer_sleep_until64(uint64_t target)
+{
+    if (irq_is_in()) {
+        uint64_t now = xtimer_now64();
+        assert((target <= now) || ((target - now) <= UINT32_MAX));
+        if (target > now) {
+            xtimer_spin((uint32_t)(target - now));
+        }
+        return;
+    }
+
+    xtimer_t timer;
+    mutex_t mutex = MUTEX_INIT;
+
+    timer.callback = _callback_unlock_mutex;
+    timer.arg = (void*) &mutex;
+    timer.target = timer.long_target = 0;
+
+    mutex_lock(&mutex);
+    if (xtimer_set_absolute64(&timer, target) == 0) {
+        mutex_lock(&mutex);
+    }
+}
+
 static void _callback_msg(void* arg)
 {
     msg_t *msg = (msg_t*)arg;
@@ -152,6 +203,15 @@ void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid)
     _xtimer_set64(timer, offset, offset >> 32);
 }
 
+int xtimer_set_wakeup_absolute64(xtimer_t *timer, uint64_t target,
+                                 kernel_pid_t pid)
+{
+    timer->callback = _callback_wakeup;
+    timer->arg = (void*) ((intptr_t)pid);
+
+    return xtimer_set_absolute64(timer, target);
+}
+
 void xtimer_now_timex(timex_t *out)
 {
     uint64_t now = xtimer_now64();
@@ -22,6 +22,10 @@
 #include "xtimer.h"
 #include "irq.h"
 
+#ifdef MODULE_TRACE
+#include "trace.h"
+#endif
+
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -143,6 +147,9 @@ static void _periph_timer_callback(void *arg, int chan)
 
 static void _shoot(xtimer_t *timer)
 {
+#ifdef MODULE_TRACE
+    trace_event(TRACE_XTIMER_FIRE, (uintptr_t)timer->callback);
+#endif
     timer->callback(timer->arg);
 }
 
@@ -0,0 +1,619 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_xtimer
+ * @{
+ * @file
+ * @brief xtimer core functionality based on a hierarchical timing wheel
+ *
+ * Replaces xtimer_core.c when the `xtimer_wheel` module is used. Timers are
+ * sorted into the wheel by their 64bit absolute target time relative to the
+ * wheel's base time. Level l holds timers whose target first differs from the
+ * base in bits [4l, 4l + 4), indexed by these bits. Whenever a timer fires,
+ * the base advances to its target and the slots the new base falls into are
+ * cascaded down to finer levels.
+ *
+ * @author agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "xtimer.h"
+#include "irq.h"
+#include "bitarithm.h"
+
+#ifdef MODULE_TRACE
+#include "trace.h"
+#endif
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define WHEEL_BITS          (4U)
+#define WHEEL_SLOTS         (1U << WHEEL_BITS)
+#define WHEEL_SPAN          (WHEEL_BITS * XTIMER_WHEEL_LEVELS)
+
+#if (WHEEL_SPAN >= 64) || (XTIMER_WHEEL_LEVELS < 1)
+#error "xtimer_wheel: XTIMER_WHEEL_LEVELS must be between 1 and 15"
+#endif
+
+#if XTIMER_MASK
+#define PERIOD_LENGTH       ((uint64_t)(uint32_t)(~XTIMER_MASK_SHIFTED + 1))
+#else
+#define PERIOD_LENGTH       (1ULL << 32)
+#endif
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _high_cnt = 0;
+#endif
+
+static xtimer_t *_wheel[XTIMER_WHEEL_LEVELS][WHEEL_SLOTS];
+static uint16_t _wheel_used[XTIMER_WHEEL_LEVELS];
+static xtimer_t *_far_list = NULL;  /* targets beyond the wheel's span */
+static xtimer_t *_late_list = NULL; /* targets before the wheel's base */
+static uint64_t _base = 0;
+static xtimer_t *_head = NULL;      /* timer with the earliest target */
+
+static void _shoot(xtimer_t *timer);
+static void _remove(xtimer_t *timer);
+static inline void _lltimer_set(uint32_t target);
+static uint32_t _time_left(uint32_t target, uint32_t reference);
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+/**
+ * @brief check if a timer is in the wheel
+ *
+ * Callers only zero target and long_target before first use, so prev is only
+ * looked at for timers that were set before. It is NULL once they fired or
+ * got removed.
+ */
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target) && timer->prev;
+}
+
+static inline uint64_t _target64(const xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline uint64_t _period_start(void)
+{
+#if XTIMER_MASK
+    return ((uint64_t)_long_cnt << 32) | _high_cnt;
+#else
+    return ((uint64_t)_long_cnt << 32);
+#endif
+}
+
+/**
+ * @brief check if a timer expires in the current short timer period
+ */
+static inline int _this_period(const xtimer_t *timer)
+{
+    return timer && (_target64(timer) < (_period_start() + PERIOD_LENGTH));
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER, XTIMER_USEC_TO_TICKS(1000000ul), _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    _lltimer_set(0xFFFFFFFF);
+}
+
+static void _xtimer_now64(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of xtimer_now() */
+    do {
+        before = xtimer_now();
+        long_value = _long_cnt;
+        after = xtimer_now();
+
+    } while(before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now64(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+/**
+ * @brief get the list a timer with the given target belongs to
+ *
+ * @param[out] level    wheel level of the list, XTIMER_WHEEL_LEVELS for the
+ *                      late and far lists
+ */
+static xtimer_t **_list(uint64_t target, unsigned *level)
+{
+    uint64_t diff = target ^ _base;
+    unsigned l = 0;
+
+    if (target < _base) {
+        *level = XTIMER_WHEEL_LEVELS;
+        return &_late_list;
+    }
+    if (diff >> WHEEL_SPAN) {
+        *level = XTIMER_WHEEL_LEVELS;
+        return &_far_list;
+    }
+    while (diff >>= WHEEL_BITS) {
+        l++;
+    }
+    *level = l;
+    return &_wheel[l][(target >> (l * WHEEL_BITS)) & (WHEEL_SLOTS - 1)];
+}
+
+/**
+ * @brief append a timer to its list
+ *
+ * Lists are NULL terminated in forward direction, while the first timer's
+ * prev points to the last one, so appending is O(1). Appending keeps timers
+ * with equal targets in the order they were set.
+ */
+static void _link(xtimer_t *timer)
+{
+    unsigned level;
+    xtimer_t **list = _list(_target64(timer), &level);
+
+    timer->next = NULL;
+    if (*list) {
+        timer->prev = (*list)->prev;
+        timer->prev->next = timer;
+        (*list)->prev = timer;
+    }
+    else {
+        timer->prev = timer;
+        *list = timer;
+        if (level < XTIMER_WHEEL_LEVELS) {
+            _wheel_used[level] |= (1 << (list - _wheel[level]));
+        }
+    }
+}
+
+/**
+ * @brief remove a timer from its list
+ */
+static void _unlink(xtimer_t *timer)
+{
+    unsigned level;
+    xtimer_t **list = _list(_target64(timer), &level);
+
+    if (*list == timer) {
+        *list = timer->next;
+        if (*list) {
+            (*list)->prev = timer->prev;
+        }
+        else if (level < XTIMER_WHEEL_LEVELS) {
+            _wheel_used[level] &= ~(1 << (list - _wheel[level]));
+        }
+    }
+    else {
+        timer->prev->next = timer->next;
+        if (timer->next) {
+            timer->next->prev = timer->prev;
+        }
+        else {
+            (*list)->prev = timer->prev;
+        }
+    }
+    timer->prev = NULL;
+}
+
+static void _relink(xtimer_t *list)
+{
+    while (list) {
+        xtimer_t *next = list->next;
+        _link(list);
+        list = next;
+    }
+}
+
+/**
+ * @brief advance the wheel's base to @p base
+ *
+ * No timer may have a target before @p base.
+ */
+static void _advance(uint64_t base)
+{
+    uint64_t old = _base;
+
+    _base = base;
+
+    if ((old ^ base) >> WHEEL_SPAN) {
+        /* the base entered a new span, so far timers may fit into the wheel */
+        xtimer_t *list = _far_list;
+        _far_list = NULL;
+        _relink(list);
+    }
+    /* timers in the slot the new base falls into belong to finer levels now */
+    for (unsigned l = XTIMER_WHEEL_LEVELS - 1; l > 0; l--) {
+        unsigned slot = (base >> (l * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+        xtimer_t *list = _wheel[l][slot];
+
+        if (list) {
+            _wheel[l][slot] = NULL;
+            _wheel_used[l] &= ~(1 << slot);
+            _relink(list);
+        }
+    }
+}
+
+/**
+ * @brief find the first timer with the earliest target in a list
+ */
+static xtimer_t *_min(xtimer_t *list)
+{
+    xtimer_t *res = list;
+
+    while (list) {
+        if (_target64(list) < _target64(res)) {
+            res = list;
+        }
+        list = list->next;
+    }
+    return res;
+}
+
+/**
+ * @brief find the timer with the earliest target
+ *
+ * Late timers come before all others. Otherwise the earliest target is in the
+ * first used slot of the finest used level.
+ */
+static xtimer_t *_first(void)
+{
+    if (_late_list) {
+        return _min(_late_list);
+    }
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        if (_wheel_used[l]) {
+            return _min(_wheel[l][bitarithm_lsb(_wheel_used[l])]);
+        }
+    }
+    return _min(_far_list);
+}
+
+static void _add(xtimer_t *timer)
+{
+    _link(timer);
+
+    if (!_head || (_target64(timer) < _target64(_head))) {
+        _head = timer;
+        if (_this_period(timer)) {
+            DEBUG("xtimer_wheel: timer is new head. updating lltimer.\n");
+            _lltimer_set(timer->target - XTIMER_OVERHEAD);
+        }
+    }
+}
+
+/**
+ * @brief remove the timer with the earliest target after it expired
+ */
+static void _pop(xtimer_t *timer)
+{
+    _unlink(timer);
+    if (_target64(timer) > _base) {
+        _advance(_target64(timer));
+    }
+    _head = _first();
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        xtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        int state = irq_disable();
+        if (_is_set(timer)) {
+            _remove(timer);
+        }
+
+        _xtimer_now64(&timer->target, &timer->long_target);
+        timer->target += offset;
+        timer->long_target += long_offset;
+        if (timer->target < offset) {
+            timer->long_target++;
+        }
+
+        _add(timer);
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+                timer->long_target, timer->target);
+    }
+}
+
+void xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n", offset, xtimer_now(), _lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        xtimer_spin(offset);
+        _shoot(timer);
+    }
+    else {
+        uint32_t target = xtimer_now() + offset;
+        _xtimer_set_absolute(timer, target);
+    }
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+static void _shoot(xtimer_t *timer)
+{
+#ifdef MODULE_TRACE
+    trace_event(TRACE_XTIMER_FIRE, (uintptr_t)timer->callback);
+#endif
+    timer->callback(timer->arg);
+}
+
+static inline void _lltimer_set(uint32_t target)
+{
+    if (_in_handler) {
+        return;
+    }
+    DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _lltimer_mask(target));
+#ifdef XTIMER_SHIFT
+    target = XTIMER_USEC_TO_TICKS(target);
+    if (!target) {
+        target++;
+    }
+#endif
+    timer_set_absolute(XTIMER, XTIMER_CHAN, _lltimer_mask(target));
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = xtimer_now();
+    int res = 0;
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    timer->next = NULL;
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        _shoot(timer);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+
+    timer->target = target;
+    timer->long_target = _long_cnt;
+    if (target < now) {
+        timer->long_target++;
+    }
+
+    _add(timer);
+
+    irq_restore(state);
+
+    return res;
+}
+
+static void _remove(xtimer_t *timer)
+{
+    _unlink(timer);
+
+    /* a removed timer must not be looked for again */
+    timer->target = 0;
+    timer->long_target = 0;
+
+    if (_head == timer) {
+        uint32_t next;
+        _head = _first();
+        if (_this_period(_head)) {
+            /* schedule callback on next timer target time */
+            next = _head->target - XTIMER_OVERHEAD;
+        }
+        else {
+            next = _lltimer_mask(0xFFFFFFFF);
+        }
+        _lltimer_set(next);
+    }
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    irq_restore(state);
+}
+
+static uint32_t _time_left(uint32_t target, uint32_t reference)
+{
+    uint32_t now = _lltimer_now();
+
+    if (now < reference) {
+        return 0;
+    }
+
+    if (target > now) {
+        return target - now;
+    }
+    else {
+        return 0;
+    }
+}
+
+/**
+ * @brief time left until @p timer expires, 0 if it is from an earlier period
+ */
+static inline uint32_t _timer_left(xtimer_t *timer, uint32_t reference)
+{
+    if (_target64(timer) < _period_start()) {
+        return 0;
+    }
+    return _time_left(_lltimer_mask(timer->target), reference);
+}
+
+/**
+ * @brief handle low-level timer overflow, advance to next short timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _high_cnt += ~XTIMER_MASK_SHIFTED + 1;
+    if (! _high_cnt) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint32_t next_target;
+    uint32_t reference;
+
+    _in_handler = 1;
+
+    DEBUG("_timer_callback() now=%" PRIu32 " (%" PRIu32 ")pleft=%" PRIu32 "\n", xtimer_now(),
+            _lltimer_mask(xtimer_now()), _lltimer_mask(0xffffffff-xtimer_now()));
+
+    if (!_this_period(_head)) {
+        DEBUG("_timer_callback(): tick\n");
+        /* there's no timer for this timer period,
+         * so this was a timer overflow callback.
+         *
+         * In this case, we advance to the next timer period.
+         */
+        _next_period();
+
+        reference = 0;
+
+        /* make sure the timer counter also arrived
+         * in the next timer period */
+        while (_lltimer_now() == _lltimer_mask(0xFFFFFFFF));
+    }
+    else {
+        /* we ended up in _timer_callback and there is
+         * a timer waiting.
+         */
+        /* set our period reference to the current time. */
+        reference = _lltimer_now();
+    }
+
+overflow:
+    /* check if next timers are close to expiring */
+    while (_this_period(_head) && (_timer_left(_head, reference) < XTIMER_ISR_BACKOFF)) {
+        /* make sure we don't fire too early */
+        while (_timer_left(_head, reference));
+
+        /* pick earliest timer */
+        xtimer_t *timer = _head;
+
+        /* advance wheel */
+        _pop(timer);
+
+        /* make sure timer is recognized as being already fired */
+        timer->target = 0;
+        timer->long_target = 0;
+
+        /* fire timer */
+        _shoot(timer);
+    }
+
+    /* possibly executing all callbacks took enough
+     * time to overflow.  In that case we advance to
+     * next timer period and check again for expired
+     * timers.*/
+    if (reference > _lltimer_now()) {
+        DEBUG("_timer_callback: overflowed while executing callbacks. %i\n", _head != 0);
+        _next_period();
+        reference = 0;
+        goto overflow;
+    }
+
+    if (_this_period(_head)) {
+        /* schedule callback on next timer target time */
+        next_target = _head->target - XTIMER_OVERHEAD;
+
+        /* make sure we're not setting a time in the past */
+        if (next_target < (_lltimer_now() + XTIMER_ISR_BACKOFF)) {
+            goto overflow;
+        }
+    }
+    else {
+        /* there's no timer planned for this timer period */
+        /* schedule callback on next overflow */
+        next_target = _lltimer_mask(0xFFFFFFFF);
+        uint32_t now = _lltimer_now();
+
+        /* check for overflow again */
+        if (now < reference) {
+            _next_period();
+            reference = 0;
+            goto overflow;
+        }
+        else {
+            /* check if the end of this period is very soon */
+            if (_lltimer_mask(now + XTIMER_ISR_BACKOFF) < now) {
+                /* spin until next period, then advance */
+                while (_lltimer_now() >= now);
+                _next_period();
+                reference = 0;
+                goto overflow;
+            }
+        }
+    }
+
+    _in_handler = 0;
+
+    /* set low level timer */
+    _lltimer_set(next_target);
+}
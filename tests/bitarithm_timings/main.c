@@ -50,9 +50,7 @@ static void run_test(const char *name, unsigned (*test)(unsigned))
     unsigned i = 0;
     unsigned long count = 0;
 
-    xtimer_t xtimer;
-    xtimer.callback = callback;
-    xtimer.arg = (void *) &done;
+    xtimer_t xtimer = { .callback = callback, .arg = (void *) &done };
 
     xtimer_set(&xtimer, TIMEOUT);
 
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test the channel template and compare its producer/consumer
+ *        throughput with a queue guarded by mutex and condition_variable
+ *
+ * @author agent <agent@local>
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cassert>
+#include <memory>
+#include <cstring>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "xtimer.h"
+
+#include "riot/mutex.hpp"
+#include "riot/chrono.hpp"
+#include "riot/thread.hpp"
+#include "riot/channel.hpp"
+#include "riot/condition_variable.hpp"
+
+#ifndef ITEMS
+#define ITEMS   (1000U)
+#endif
+
+#define CAPACITY            (4U)
+#define MAIN_QUEUE_SIZE     (8U)
+#define OTHER_MSG_TYPE      (0x0123)
+
+using namespace std;
+using namespace riot;
+
+struct sample {
+  uint32_t seq;
+  uint8_t data[28];
+};
+
+static msg_t main_queue[MAIN_QUEUE_SIZE];
+
+/**
+ * @brief Bounded queue as hand-rolled with mutex and condition_variable
+ */
+class locked_queue {
+ public:
+  locked_queue() : m_head{0}, m_count{0} {}
+
+  void push(uint32_t value) {
+    unique_lock<mutex> lock(m_mtx);
+    while (m_count == CAPACITY) {
+      m_not_full.wait(lock);
+    }
+    m_items[(m_head + m_count) % CAPACITY] = value;
+    m_count++;
+    m_not_empty.notify_one();
+  }
+
+  uint32_t pop() {
+    unique_lock<mutex> lock(m_mtx);
+    while (m_count == 0) {
+      m_not_empty.wait(lock);
+    }
+    uint32_t value = m_items[m_head];
+    m_head = (m_head + 1) % CAPACITY;
+    m_count--;
+    m_not_full.notify_one();
+    return value;
+  }
+
+ private:
+  mutex m_mtx;
+  condition_variable m_not_empty;
+  condition_variable m_not_full;
+  uint32_t m_items[CAPACITY];
+  unsigned m_head;
+  unsigned m_count;
+};
+
+static void print_result(const char* name, uint32_t time) {
+  if (time == 0) {
+    time = 1;
+  }
+  printf("+ %-26s %8" PRIu32 " us, %8" PRIu32 " items/s\n", name, time,
+         (uint32_t)(((uint64_t)ITEMS * SEC_IN_USEC) / time));
+}
+
+int main() {
+  puts("\n************ C++ channel test ***********");
+
+  msg_init_queue(main_queue, MAIN_QUEUE_SIZE);
+
+  puts("Sending inline values from another thread ...");
+  {
+    channel<int, CAPACITY> ch;
+    thread t([&ch] {
+      for (int i = 0; i < 10; i++) {
+        assert(ch.send(i));
+      }
+    });
+    for (int i = 0; i < 10; i++) {
+      int value;
+      ch.receive(value);
+      assert(value == i);
+    }
+    t.join();
+  }
+  puts("Done\n");
+
+  puts("Sending large and move-only values ...");
+  {
+    channel<sample, CAPACITY> ch;
+    channel<unique_ptr<int>, CAPACITY> ptrs;
+    thread t([&ch, &ptrs] {
+      for (uint32_t i = 0; i < 10; i++) {
+        sample s;
+        s.seq = i;
+        memset(s.data, (int)i, sizeof(s.data));
+        assert(ch.send(s));
+        assert(ptrs.send(unique_ptr<int>(new int(i))));
+      }
+    });
+    for (uint32_t i = 0; i < 10; i++) {
+      sample s;
+      unique_ptr<int> p;
+      ch.receive(s);
+      assert((s.seq == i) && (s.data[27] == i));
+      ptrs.receive(p);
+      assert(p && (*p == (int)i));
+    }
+    t.join();
+  }
+  puts("Done\n");
+
+  puts("Filling a channel ...");
+  {
+    channel<int, CAPACITY> ch;
+    int value;
+    for (unsigned i = 0; i < CAPACITY; i++) {
+      assert(ch.try_send(i));
+    }
+    assert(!ch.try_send(CAPACITY));
+    assert(!ch.send_for(CAPACITY, chrono::milliseconds(10)));
+    for (unsigned i = 0; i < CAPACITY; i++) {
+      assert(ch.try_receive(value) && (value == (int)i));
+    }
+    assert(!ch.try_receive(value));
+    assert(!ch.receive_for(value, chrono::milliseconds(10)));
+  }
+  puts("Done\n");
+
+  puts("Sending to a receiver with a full message queue ...");
+  {
+    channel<int, CAPACITY> ch;
+    kernel_pid_t main_pid = thread_getpid();
+    msg_t msg, other;
+    int value;
+    msg.type = OTHER_MSG_TYPE;
+    for (unsigned i = 0; i < MAIN_QUEUE_SIZE; i++) {
+      msg.content.value = i;
+      assert(msg_send_to_self(&msg) == 1);
+    }
+    thread t1([&ch] {
+      // neither may block while the receiver's queue stays full
+      assert(!ch.try_send(1));
+      assert(!ch.send_for(2, chrono::milliseconds(10)));
+    });
+    t1.join();
+    // other messages are handed back, not dropped
+    for (unsigned i = 0; i < MAIN_QUEUE_SIZE; i++) {
+      assert(ch.try_receive(value, other) == -1);
+      assert((other.type == OTHER_MSG_TYPE) && (other.content.value == i));
+    }
+    assert(ch.try_receive(value, other) == 0);
+    // the failed sends gave their slots back
+    for (unsigned i = 0; i < CAPACITY; i++) {
+      assert(ch.try_send(i));
+    }
+    for (unsigned i = 0; i < CAPACITY; i++) {
+      assert(ch.try_receive(value) && (value == (int)i));
+    }
+    thread t2([&ch, main_pid] {
+      msg_t msg;
+      msg.type = OTHER_MSG_TYPE;
+      msg.content.value = 42;
+      assert(msg_send(&msg, main_pid) == 1);
+      assert(ch.send(5));
+    });
+    assert(select(other, ch) == select_other);
+    assert(other.content.value == 42);
+    assert(ch.receive(value, other) && (value == 5));
+    t2.join();
+  }
+  puts("Done\n");
+
+  puts("Selecting from several channels ...");
+  {
+    channel<int, CAPACITY> a;
+    channel<sample, CAPACITY> b;
+    int value;
+    sample s;
+    assert(try_select(a, b) == -1);
+    assert(select_for(chrono::milliseconds(10), a, b) == -1);
+    thread t([&a, &b] {
+      sample s;
+      s.seq = 7;
+      assert(b.send(s));
+      assert(a.send(3));
+    });
+    assert(select(a, b) == 1);
+    assert(b.try_receive(s) && (s.seq == 7));
+    assert(select(a, b) == 0);
+    // the value was stashed in a while waiting on both
+    assert(a.try_receive(value) && (value == 3));
+    t.join();
+  }
+  puts("Done\n");
+
+  puts("Comparing producer/consumer throughput ...");
+  {
+    uint32_t start, sum;
+
+    locked_queue q;
+    sum = 0;
+    start = xtimer_now();
+    thread t1([&q] {
+      for (uint32_t i = 0; i < ITEMS; i++) {
+        q.push(i);
+      }
+    });
+    for (uint32_t i = 0; i < ITEMS; i++) {
+      sum += q.pop();
+    }
+    print_result("mutex + condition_variable", xtimer_now() - start);
+    t1.join();
+    uint32_t expected = sum;
+
+    channel<uint32_t, CAPACITY> inline_ch;
+    sum = 0;
+    start = xtimer_now();
+    thread t2([&inline_ch] {
+      for (uint32_t i = 0; i < ITEMS; i++) {
+        inline_ch.send(i);
+      }
+    });
+    for (uint32_t i = 0; i < ITEMS; i++) {
+      uint32_t value;
+      inline_ch.receive(value);
+      sum += value;
+    }
+    print_result("channel, inline", xtimer_now() - start);
+    t2.join();
+    assert(sum == expected);
+
+    channel<sample, CAPACITY> slot_ch;
+    sum = 0;
+    start = xtimer_now();
+    thread t3([&slot_ch] {
+      sample s;
+      memset(s.data, 0, sizeof(s.data));
+      for (uint32_t i = 0; i < ITEMS; i++) {
+        s.seq = i;
+        slot_ch.send(s);
+      }
+    });
+    for (uint32_t i = 0; i < ITEMS; i++) {
+      sample s;
+      slot_ch.receive(s);
+      sum += s.seq;
+    }
+    print_result("channel, slots", xtimer_now() - start);
+    t3.join();
+    assert(sum == expected);
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
@@ -21,16 +21,61 @@
 #include <string>
 #include <cstdio>
 #include <cassert>
+#include <inttypes.h>
 #include <system_error>
 
+#include "xtimer.h"
+
 #include "riot/mutex.hpp"
 #include "riot/chrono.hpp"
 #include "riot/thread.hpp"
 #include "riot/condition_variable.hpp"
 
+#ifndef JITTER_ROUNDS
+#define JITTER_ROUNDS   (20U)
+#endif
+
+/* maximum time in microseconds a timed wait may return late, not checked on
+ * native where the host adds its scheduling latency */
+#ifndef MAX_JITTER
+#define MAX_JITTER      (2000U)
+#endif
+
 using namespace std;
 using namespace riot;
 
+/**
+ * @brief Tracks how late timed waits return
+ */
+struct jitter {
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+  uint64_t sum = 0;
+  unsigned rounds = 0;
+
+  void add(uint64_t target, uint64_t woken) {
+    // a timed wait must never return early
+    assert(woken >= target);
+    uint32_t late = static_cast<uint32_t>(woken - target);
+    min = (late < min) ? late : min;
+    max = (late > max) ? late : max;
+    sum += late;
+    rounds++;
+  }
+
+  void print(const char* name) const {
+    printf("+ %-12s late by min %" PRIu32 " us, avg %" PRIu32 " us, max %"
+           PRIu32 " us\n", name, min, static_cast<uint32_t>(sum / rounds),
+           max);
+#ifndef BOARD_NATIVE
+    assert(max <= MAX_JITTER);
+#endif
+  }
+};
+
+/* timeouts covering relative and absolute timer setup paths */
+static const uint32_t jitter_timeouts[] = { 100, 1000, 10000, 50000 };
+
 /* http://en.cppreference.com/w/cpp/thread/condition_variable */
 int main() {
   puts("\n************ C++ condition_variable test ***********");
@@ -123,6 +168,64 @@ int main() {
   }
   puts("Done\n");
 
+  puts("Jitter of wait_until, wait_for and sleep_until ...");
+  {
+    mutex m;
+    condition_variable cv;
+    jitter until, wait_for, sleep;
+    unique_lock<mutex> lk(m);
+    for (unsigned i = 0; i < JITTER_ROUNDS; i++) {
+      for (uint32_t us : jitter_timeouts) {
+        auto time = riot::now() += chrono::microseconds(us);
+        uint64_t target = timex_uint64(time.native_handle());
+        assert(cv.wait_until(lk, time) == cv_status::timeout);
+        until.add(target, xtimer_now64());
+
+        target = xtimer_now64() + us;
+        assert(cv.wait_for(lk, chrono::microseconds(us)) == cv_status::timeout);
+        wait_for.add(target, xtimer_now64());
+
+        auto wakeup = riot::now() += chrono::microseconds(us);
+        target = timex_uint64(wakeup.native_handle());
+        this_thread::sleep_until(wakeup);
+        sleep.add(target, xtimer_now64());
+      }
+    }
+    until.print("wait_until");
+    wait_for.print("wait_for");
+    sleep.print("sleep_until");
+  }
+  puts("Done\n");
+
+  puts("Wait until a time point that passed already ...");
+  {
+    mutex m;
+    condition_variable cv;
+    unique_lock<mutex> lk(m);
+    auto time = riot::now();
+    assert(cv.wait_until(lk, time) == cv_status::timeout);
+    assert(lk.owns_lock());
+  }
+  puts("Done\n");
+
+  puts("Notify before the timeout ...");
+  {
+    mutex m;
+    condition_variable cv;
+    bool ready = false;
+    unique_lock<mutex> lk(m);
+    thread notifier([&m, &cv, &ready] {
+      this_thread::sleep_for(chrono::milliseconds(10));
+      lock_guard<mutex> lk(m);
+      ready = true;
+      cv.notify_one();
+    });
+    assert(cv.wait_for(lk, chrono::seconds(1), [&ready] { return ready; }));
+    lk.unlock();
+    notifier.join();
+  }
+  puts("Done\n");
+
   puts("Bye, bye. ");
   puts("******************************************************\n");
 
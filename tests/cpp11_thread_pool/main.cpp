@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test thread pool, future and promise and compare the cost of
+ *        spawning a thread per task with pooled submission
+ *
+ * @author agent <agent@local>
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cassert>
+#include <memory>
+#include <inttypes.h>
+#include <system_error>
+
+#include "xtimer.h"
+
+#include "riot/chrono.hpp"
+#include "riot/future.hpp"
+#include "riot/thread.hpp"
+#include "riot/thread_pool.hpp"
+
+#ifndef TASKS
+#define TASKS   (100U)
+#endif
+
+using namespace std;
+using namespace riot;
+
+using pool_type = thread_pool<2, 4>;
+
+static unsigned counter;
+
+static void count_task() { counter++; }
+
+static void print_result(const char* name, uint32_t time) {
+  printf("+ %-22s %8" PRIu32 " us, %6" PRIu32 " us per task\n", name, time,
+         time / TASKS);
+}
+
+int main() {
+  puts("\n************ C++ thread pool test ***********");
+
+  assert(sched_num_threads == 2); // main + idle
+
+  puts("Fulfilling a promise from another thread ...");
+  {
+    promise<int> p;
+    auto f = p.get_future();
+    assert(f.valid());
+    thread t([](promise<int>& p) { p.set_value(42); }, move(p));
+    assert(f.get() == 42);
+    assert(!f.valid());
+    t.join();
+  }
+  puts("Done\n");
+
+  puts("Breaking a promise ...");
+  {
+    future<int> f;
+    {
+      promise<int> p;
+      f = p.get_future();
+    }
+    try {
+      f.get();
+      assert(false);
+    }
+    catch (const std::system_error& e) {
+      // expected
+    }
+  }
+  puts("Done\n");
+
+  puts("Waiting for a future with timeout ...");
+  {
+    promise<void> p;
+    auto f = p.get_future();
+    assert(f.wait_for(chrono::milliseconds(10)) == future_status::timeout);
+    p.set_value();
+    assert(f.wait_for(chrono::milliseconds(10)) == future_status::ready);
+    f.get();
+  }
+  puts("Done\n");
+
+  puts("Running a task with async ...");
+  {
+    auto f = riot::async([](int a, int b) { return a + b; }, 1, 2);
+    assert(f.get() == 3);
+    auto g = riot::async([] { throw std::runtime_error("nope"); });
+    try {
+      g.get();
+      assert(false);
+    }
+    catch (const std::system_error& e) {
+      // expected
+    }
+  }
+  puts("Done\n");
+
+  assert(sched_num_threads == 2);
+
+  puts("Running tasks on a thread pool ...");
+  {
+    // the pool's stacks are too large for main's stack
+    unique_ptr<pool_type> pool{new pool_type};
+    assert(sched_num_threads == 4);
+    assert(pool->size() == 2);
+
+    auto f = pool->async([](int a) { return a * a; }, 7);
+    assert(f.get() == 49);
+
+    // block both workers, so the queue fills up
+    promise<void> gate;
+    auto open = make_shared<future<void>>(gate.get_future());
+    auto blocked = [open] { open->wait(); };
+    pool->submit(blocked);
+    pool->submit(blocked);
+    counter = 0;
+    for (unsigned i = 0; i < 4; i++) {
+      assert(pool->try_submit(count_task));
+    }
+    assert(!pool->try_submit(count_task));
+    gate.set_value();
+    // the destructor runs the queued tasks
+    pool.reset();
+    assert(counter == 4);
+  }
+  puts("Done\n");
+
+  assert(sched_num_threads == 2);
+
+  puts("Comparing spawn per task with pooled submission ...");
+  {
+    uint32_t start;
+
+    counter = 0;
+    start = xtimer_now();
+    for (unsigned i = 0; i < TASKS; i++) {
+      thread t(count_task);
+      t.join();
+    }
+    print_result("spawn and join", xtimer_now() - start);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < TASKS; i++) {
+      riot::async(count_task).get();
+    }
+    print_result("async", xtimer_now() - start);
+
+    unique_ptr<pool_type> pool{new pool_type};
+    start = xtimer_now();
+    for (unsigned i = 0; i < TASKS; i++) {
+      pool->async(count_task).get();
+    }
+    print_result("pool async", xtimer_now() - start);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < TASKS; i++) {
+      pool->submit(count_task);
+    }
+    pool.reset();
+    print_result("pool submit", xtimer_now() - start);
+
+    assert(counter == (4 * TASKS));
+  }
+  puts("Done\n");
+
+  assert(sched_num_threads == 2);
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
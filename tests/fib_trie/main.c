@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the FIB unit tests with the `fib_trie` module
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "xtimer.h"
+#include "tests-fib.h"
+
+int main(void)
+{
+    /* auto_init is disabled, but the FIB uses xtimer for lifetimes */
+    xtimer_init();
+
+    TESTS_START();
+    tests_fib();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of sending packets to a few routed
+ *              destinations and checks that changes of the forwarding table
+ *              and the neighbor cache take effect right away
+ *
+ * The main thread acts as the network interface: it receives the packets
+ * IPv6 sends over it and checks their link layer destination.
+ * Build with `DESTINATION_CACHE=0` to compare with the send cost without
+ * the destination cache.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "net/fib.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif/hdr.h"
+
+#ifndef ROUNDS
+#define ROUNDS          (1000U)
+#endif
+
+#define DESTS           (4U)
+#define PAYLOAD_SIZE    (16U)
+#define L2ADDR_LEN      (8U)
+#define QUEUE_SIZE      (8U)
+#define TIMEOUT         (SEC_IN_USEC)
+
+static msg_t main_queue[QUEUE_SIZE];
+static kernel_pid_t iface;
+
+/* fd01::1 */
+static ipv6_addr_t own = {{ 0xfd, 0x01, 0, 0, 0, 0, 0, 0,
+                            0, 0, 0, 0, 0, 0, 0, 0x01 }};
+/* fe80::2 and fe80::3 */
+static ipv6_addr_t routers[] = {
+    {{ 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02 }},
+    {{ 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x03 }},
+};
+static uint8_t router_l2addrs[][L2ADDR_LEN] = {
+    { 0x02, 0, 0, 0, 0, 0, 0, 0x02 },
+    { 0x02, 0, 0, 0, 0, 0, 0, 0x03 },
+    { 0x02, 0, 0, 0, 0, 0, 0, 0x04 },
+};
+
+static void _dst(ipv6_addr_t *dst, unsigned i)
+{
+    /* 2001:db8::i, routed over the default route */
+    memset(dst, 0, sizeof(ipv6_addr_t));
+    dst->u8[0] = 0x20;
+    dst->u8[1] = 0x01;
+    dst->u8[2] = 0x0d;
+    dst->u8[3] = 0xb8;
+    dst->u8[15] = i + 1;
+}
+
+static int _set_default_route(const ipv6_addr_t *router)
+{
+    return fib_add_entry(&gnrc_ipv6_fib_table, iface,
+                         (uint8_t *)ipv6_addr_unspecified.u8, sizeof(ipv6_addr_t),
+                         0, (uint8_t *)router->u8, sizeof(ipv6_addr_t), 0,
+                         (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+static int _send(unsigned i)
+{
+    ipv6_addr_t dst;
+    gnrc_pktsnip_t *payload, *ip;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -1;
+    }
+    _dst(&dst, i);
+    /* source is left to source address selection */
+    ip = gnrc_ipv6_hdr_build(payload, NULL, &dst);
+    if (ip == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -1;
+    }
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6,
+                                   GNRC_NETREG_DEMUX_CTX_ALL, ip)) {
+        gnrc_pktbuf_release(ip);
+        return -1;
+    }
+    return 0;
+}
+
+/* receives the packet sent to destination i, returns -1 if it is not sent
+ * to the link layer address l2addr */
+static int _expect(unsigned i, const uint8_t *l2addr)
+{
+    gnrc_pktsnip_t *pkt;
+    gnrc_netif_hdr_t *netif_hdr;
+    ipv6_hdr_t *ipv6_hdr;
+    ipv6_addr_t dst;
+    msg_t msg;
+    int res = 0;
+
+    if (xtimer_msg_receive_timeout(&msg, TIMEOUT) < 0) {
+        printf("error: packet to destination %u was not sent\n", i);
+        return -1;
+    }
+    if (msg.type != GNRC_NETAPI_MSG_TYPE_SND) {
+        printf("error: unexpected message type 0x%04x\n", msg.type);
+        return -1;
+    }
+    pkt = (gnrc_pktsnip_t *)msg.content.ptr;
+    netif_hdr = pkt->data;
+    ipv6_hdr = pkt->next->data;
+    _dst(&dst, i);
+    if ((netif_hdr->dst_l2addr_len != L2ADDR_LEN) ||
+        (memcmp(gnrc_netif_hdr_get_dst_addr(netif_hdr), l2addr,
+                L2ADDR_LEN) != 0)) {
+        printf("error: packet to destination %u sent to wrong next hop\n", i);
+        res = -1;
+    }
+    else if (!ipv6_addr_equal(&ipv6_hdr->dst, &dst) ||
+             !ipv6_addr_equal(&ipv6_hdr->src, &own)) {
+        printf("error: packet to destination %u has wrong addresses\n", i);
+        res = -1;
+    }
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+static int _send_and_expect(unsigned i, const uint8_t *l2addr)
+{
+    if (_send(i) < 0) {
+        printf("error: can't send packet to destination %u\n", i);
+        return -1;
+    }
+    return _expect(i, l2addr);
+}
+
+int main(void)
+{
+    uint32_t start, time;
+
+    puts("IPv6 destination cache test");
+
+    msg_init_queue(main_queue, QUEUE_SIZE);
+    iface = thread_getpid();
+    gnrc_ipv6_netif_add(iface);
+    gnrc_ipv6_netif_add_addr(iface, &own, 64, GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    for (unsigned i = 0; i < (sizeof(routers) / sizeof(routers[0])); i++) {
+        gnrc_ipv6_nc_add(iface, &routers[i], router_l2addrs[i], L2ADDR_LEN,
+                         GNRC_IPV6_NC_STATE_REACHABLE);
+    }
+    if (_set_default_route(&routers[0]) < 0) {
+        puts("error: can't add default route");
+        return 1;
+    }
+
+    start = xtimer_now();
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        for (unsigned i = 0; i < DESTS; i++) {
+            if (_send_and_expect(i, router_l2addrs[0]) < 0) {
+                return 1;
+            }
+        }
+    }
+    time = xtimer_now() - start;
+    printf("+ %u packets to %u destinations in %" PRIu32 " us "
+           "(%" PRIu32 " us per packet)\n", ROUNDS * DESTS, DESTS, time,
+           time / (ROUNDS * DESTS));
+
+    /* neighbor changed its link layer address */
+    gnrc_ipv6_nc_add(iface, &routers[0], router_l2addrs[2], L2ADDR_LEN,
+                     GNRC_IPV6_NC_STATE_REACHABLE);
+    if (_send_and_expect(0, router_l2addrs[2]) < 0) {
+        return 1;
+    }
+    /* default route changed */
+    fib_remove_entry(&gnrc_ipv6_fib_table, (uint8_t *)ipv6_addr_unspecified.u8,
+                     sizeof(ipv6_addr_t));
+    if (_set_default_route(&routers[1]) < 0) {
+        puts("error: can't change default route");
+        return 1;
+    }
+    for (unsigned i = 0; i < DESTS; i++) {
+        if (_send_and_expect(i, router_l2addrs[1]) < 0) {
+            return 1;
+        }
+    }
+
+    puts("Test successful.");
+    return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the neighbor cache unit tests with the
+ *              `gnrc_ipv6_nc_hash` module
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "xtimer.h"
+#include "tests-ipv6_nc.h"
+
+int main(void)
+{
+    /* auto_init is disabled, but the tests use xtimer */
+    xtimer_init();
+
+    TESTS_START();
+    tests_ipv6_nc();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the netreg unit tests with the `gnrc_netreg_hash` module
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-netreg.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_netreg();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the packet buffer unit tests with the `gnrc_pktbuf_slab`
+ *              module
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-pktbuf.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_pktbuf();
+    TESTS_END();
+
+    return 0;
+}
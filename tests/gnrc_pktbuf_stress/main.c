@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stresses the packet buffer with random packet sizes and
+ *              reports the drop rate and allocation time
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "random.h"
+#include "xtimer.h"
+
+#ifndef ROUNDS
+#define ROUNDS          (2000U)
+#endif
+
+#define SEED            (0x2a2a2a2a)
+#define ALLOC_NUMOF     (6U)    /**< packets allocated per round */
+#define LIVE_NUMOF      (2 * ALLOC_NUMOF)
+
+static gnrc_pktsnip_t *live[LIVE_NUMOF];
+static unsigned live_numof;
+
+static uint32_t packets, dropped;
+
+static size_t _random_size(void)
+{
+    uint32_t r = random_uint32() % 10;
+
+    /* mostly small and medium sized packets, some full sized ones */
+    if (r < 5) {
+        return 8 + (random_uint32() % 57);
+    }
+    else if (r < 8) {
+        return 65 + (random_uint32() % 192);
+    }
+    return 257 + (random_uint32() % 1024);
+}
+
+static gnrc_pktsnip_t *_alloc_packet(void)
+{
+    size_t payload_size = _random_size();
+    size_t hdr_size = 8 + (random_uint32() % 41);
+    gnrc_pktsnip_t *pkt;
+
+    if (random_uint32() & 1) {
+        /* receive path: the header is marked in a received frame */
+        gnrc_pktsnip_t *hdr;
+
+        pkt = gnrc_pktbuf_add(NULL, NULL, hdr_size + payload_size,
+                              GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            return NULL;
+        }
+        hdr = gnrc_pktbuf_mark(pkt, hdr_size, GNRC_NETTYPE_UNDEF);
+        if (hdr == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        }
+    }
+    else {
+        /* send path: a header is prepended to the payload */
+        gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, NULL, payload_size,
+                                                  GNRC_NETTYPE_UNDEF);
+
+        if (payload == NULL) {
+            return NULL;
+        }
+        pkt = gnrc_pktbuf_add(payload, NULL, hdr_size, GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            gnrc_pktbuf_release(payload);
+            return NULL;
+        }
+    }
+    return pkt;
+}
+
+int main(void)
+{
+    uint32_t alloc_time = 0;
+
+    puts("packet buffer stress test");
+    random_init(SEED);
+    gnrc_pktbuf_init();
+
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        /* allocate new packets ... */
+        uint32_t start = xtimer_now();
+
+        for (unsigned i = 0; i < ALLOC_NUMOF; i++) {
+            gnrc_pktsnip_t *pkt = _alloc_packet();
+
+            packets++;
+            if (pkt == NULL) {
+                dropped++;
+                continue;
+            }
+            live[live_numof++] = pkt;
+        }
+        alloc_time += xtimer_now() - start;
+
+        /* ... and release half of the packets in random order */
+        for (unsigned i = (live_numof + 1) / 2; i > 0; i--) {
+            unsigned idx = random_uint32() % live_numof;
+
+            gnrc_pktbuf_release(live[idx]);
+            live[idx] = live[--live_numof];
+        }
+    }
+
+    while (live_numof > 0) {
+        gnrc_pktbuf_release(live[--live_numof]);
+    }
+
+    printf("+ packets: %" PRIu32 ", dropped: %" PRIu32 " (%" PRIu32 ".%" PRIu32
+           " permille)\n", packets, dropped, (dropped * 1000) / packets,
+           ((dropped * 10000) / packets) % 10);
+    printf("+ allocation: %" PRIu32 " us for %" PRIu32 " packets\n",
+           alloc_time, packets);
+    gnrc_pktbuf_stats();
+
+    puts("Test successful.");
+    return 0;
+}
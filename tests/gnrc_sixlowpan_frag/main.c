@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sends oversized UDP datagrams from several threads at once
+ *              through 6LoWPAN and checks that all of them get fragmented
+ *              and reassembled again
+ *
+ * The main thread acts as the 6LoWPAN interface: it receives the fragments
+ * and passes them back to 6LoWPAN as if they had been received.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "utlist.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/netif.h"
+
+#ifndef ROUNDS
+#define ROUNDS          (100U)
+#endif
+
+/* as many datagrams as can wait for fragmentation */
+#define SENDERS         (GNRC_SIXLOWPAN_FRAG_JOB_NUMOF)
+#define PAYLOAD_SIZE    (200U)
+#define MAX_FRAG_SIZE   (64U)
+#define PORT            (61616U)
+#define L2ADDR_LEN      (8U)
+#define QUEUE_SIZE      (32U)   /* must hold all fragments of a round */
+#define TIMEOUT         (SEC_IN_USEC)
+
+static char sender_stacks[SENDERS][THREAD_STACKSIZE_MAIN];
+static kernel_pid_t senders[SENDERS];
+static msg_t main_queue[QUEUE_SIZE];
+static kernel_pid_t iface;
+
+static uint8_t src_l2addr[L2ADDR_LEN] = { 0x02, 0, 0, 0, 0, 0, 0, 0x01 };
+static uint8_t dst_l2addr[L2ADDR_LEN] = { 0x02, 0, 0, 0, 0, 0, 0, 0x02 };
+
+static inline uint8_t _pattern(unsigned sender, unsigned round, unsigned i)
+{
+    return (uint8_t)(sender + round + i);
+}
+
+static gnrc_pktsnip_t *_build(unsigned sender, unsigned round)
+{
+    ipv6_addr_t src = {{ 0xfd, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 }};
+    ipv6_addr_t dst = {{ 0xfd, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02 }};
+    gnrc_pktsnip_t *payload, *udp, *ip, *netif;
+    ipv6_hdr_t *ip_hdr;
+    udp_hdr_t *udp_hdr;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < PAYLOAD_SIZE; i++) {
+        ((uint8_t *)payload->data)[i] = _pattern(sender, round, i);
+    }
+    udp = gnrc_pktbuf_add(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UNDEF);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(PORT + sender);
+    udp_hdr->dst_port = byteorder_htons(PORT);
+    udp_hdr->length = byteorder_htons(gnrc_pkt_len(udp));
+    udp_hdr->checksum = byteorder_htons(0);
+    ip = gnrc_ipv6_hdr_build(udp, &src, &dst);
+    if (ip == NULL) {
+        gnrc_pktbuf_release(udp);
+        return NULL;
+    }
+    ip_hdr = ip->data;
+    ip_hdr->len = byteorder_htons(gnrc_pkt_len(udp));
+    ip_hdr->nh = PROTNUM_UDP;
+    ip_hdr->hl = 64;
+    netif = gnrc_netif_hdr_build(src_l2addr, L2ADDR_LEN, dst_l2addr, L2ADDR_LEN);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ip);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    LL_PREPEND(ip, netif);
+    return ip;
+}
+
+static void *sender(void *arg)
+{
+    unsigned id = (unsigned)(uintptr_t)arg;
+    msg_t msg;
+
+    while (1) {
+        gnrc_pktsnip_t *pkt;
+
+        /* wait for the next round */
+        msg_receive(&msg);
+        pkt = _build(id, msg.content.value);
+        if (pkt == NULL) {
+            printf("error: sender %u can't allocate datagram\n", id);
+            continue;
+        }
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+
+    return NULL;
+}
+
+/* passes a fragment sent over the interface back to 6LoWPAN */
+static void _loop_back(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+    gnrc_pktsnip_t *netif, *frag;
+
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_dst_addr(hdr), hdr->dst_l2addr_len,
+                                 gnrc_netif_hdr_get_src_addr(hdr), hdr->src_l2addr_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    frag = gnrc_pktbuf_add(netif, pkt->next->data, pkt->next->size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktbuf_release(pkt);
+    if (frag == NULL) {
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, frag)) {
+        gnrc_pktbuf_release(frag);
+    }
+}
+
+/* returns the sender of a reassembled datagram, -1 if it is corrupted */
+static int _check(gnrc_pktsnip_t *pkt, unsigned round)
+{
+    udp_hdr_t *udp_hdr = (udp_hdr_t *)((uint8_t *)pkt->data + sizeof(ipv6_hdr_t));
+    uint8_t *payload = (uint8_t *)(udp_hdr + 1);
+    unsigned id;
+
+    if (pkt->size != (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) + PAYLOAD_SIZE)) {
+        return -1;
+    }
+    id = byteorder_ntohs(udp_hdr->src_port) - PORT;
+    if (id >= SENDERS) {
+        return -1;
+    }
+    for (unsigned i = 0; i < PAYLOAD_SIZE; i++) {
+        if (payload[i] != _pattern(id, round, i)) {
+            return -1;
+        }
+    }
+    return id;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t entry;
+    uint32_t start, time;
+
+    puts("6LoWPAN concurrent fragmentation test");
+
+    msg_init_queue(main_queue, QUEUE_SIZE);
+    iface = thread_getpid();
+    gnrc_sixlowpan_netif_add(iface, MAX_FRAG_SIZE);
+    entry.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    entry.pid = iface;
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &entry);
+
+    /* senders preempt 6LoWPAN, so all datagrams of a round are waiting for
+     * fragmentation at the same time */
+    for (unsigned i = 0; i < SENDERS; i++) {
+        senders[i] = thread_create(sender_stacks[i], sizeof(sender_stacks[i]),
+                                   GNRC_SIXLOWPAN_PRIO - 1,
+                                   THREAD_CREATE_STACKTEST, sender,
+                                   (void *)(uintptr_t)i, "sender");
+    }
+
+    start = xtimer_now();
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        unsigned received = 0, seen = 0;
+        msg_t msg;
+
+        for (unsigned i = 0; i < SENDERS; i++) {
+            msg.content.value = round;
+            msg_send(&msg, senders[i]);
+        }
+        while (received < SENDERS) {
+            gnrc_pktsnip_t *pkt;
+            int id;
+
+            if (xtimer_msg_receive_timeout(&msg, TIMEOUT) < 0) {
+                printf("error: round %u lost %u of %u datagrams\n", round,
+                       SENDERS - received, SENDERS);
+                return 1;
+            }
+            pkt = (gnrc_pktsnip_t *)msg.content.ptr;
+            switch (msg.type) {
+                case GNRC_NETAPI_MSG_TYPE_SND:
+                    _loop_back(pkt);
+                    break;
+                case GNRC_NETAPI_MSG_TYPE_RCV:
+                    id = _check(pkt, round);
+                    gnrc_pktbuf_release(pkt);
+                    if ((id < 0) || (seen & (1 << id))) {
+                        printf("error: round %u got a corrupted datagram\n",
+                               round);
+                        return 1;
+                    }
+                    seen |= (1 << id);
+                    received++;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    time = xtimer_now() - start;
+    printf("+ %u datagrams of %u bytes in %" PRIu32 " us\n", ROUNDS * SENDERS,
+           PAYLOAD_SIZE, time);
+
+    puts("Test successful.");
+    return 0;
+}
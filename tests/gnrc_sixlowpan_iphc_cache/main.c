@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the 6LoWPAN unit tests with the
+ *              `gnrc_sixlowpan_iphc_cache` module
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "xtimer.h"
+#include "tests-sixlowpan.h"
+
+int main(void)
+{
+    /* auto_init is disabled, but the IPHC benchmark uses xtimer */
+    xtimer_init();
+
+    TESTS_START();
+    tests_sixlowpan();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Echoes UDP packets over the IPv6 loopback address and measures
+ *              round trip latency and throughput of the stack
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/udp.h"
+
+#ifndef ROUNDS
+#define ROUNDS          (1000U)
+#endif
+
+#define WINDOW          (4U)    /**< packets in flight when measuring throughput */
+#define PAYLOAD_SIZE    (32U)
+#define SERVER_PORT     (7U)
+#define CLIENT_PORT     (7007U)
+#define QUEUE_SIZE      (8U)
+#define TIMEOUT         (SEC_IN_USEC)
+
+static char server_stack[THREAD_STACKSIZE_MAIN];
+static msg_t server_queue[QUEUE_SIZE];
+static msg_t main_queue[QUEUE_SIZE];
+
+static int _send(gnrc_pktsnip_t *payload, uint16_t src, uint16_t dst)
+{
+    ipv6_addr_t addr = IPV6_ADDR_LOOPBACK;
+    gnrc_pktsnip_t *udp, *ip;
+
+    udp = gnrc_udp_hdr_build(payload, src, dst);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -1;
+    }
+    ip = gnrc_ipv6_hdr_build(udp, NULL, &addr);
+    if (ip == NULL) {
+        gnrc_pktbuf_release(udp);
+        return -1;
+    }
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   ip)) {
+        gnrc_pktbuf_release(ip);
+        return -1;
+    }
+    return 0;
+}
+
+static int _send_request(void)
+{
+    static uint8_t data[PAYLOAD_SIZE];
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, data, sizeof(data),
+                                              GNRC_NETTYPE_UNDEF);
+
+    if (payload == NULL) {
+        return -1;
+    }
+    return _send(payload, CLIENT_PORT, SERVER_PORT);
+}
+
+static int _wait_reply(void)
+{
+    msg_t msg;
+
+    do {
+        if (xtimer_msg_receive_timeout(&msg, TIMEOUT) < 0) {
+            return -1;
+        }
+    } while (msg.type != GNRC_NETAPI_MSG_TYPE_RCV);
+    gnrc_pktbuf_release((gnrc_pktsnip_t *)msg.content.ptr);
+    return 0;
+}
+
+static void *server(void *arg)
+{
+    (void)arg;
+    gnrc_netreg_entry_t entry;
+    msg_t msg;
+
+    msg_init_queue(server_queue, QUEUE_SIZE);
+    entry.demux_ctx = SERVER_PORT;
+    entry.pid = thread_getpid();
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+
+    while (1) {
+        gnrc_pktsnip_t *pkt, *payload;
+
+        msg_receive(&msg);
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            continue;
+        }
+        /* the payload is the first snip of a received packet */
+        pkt = (gnrc_pktsnip_t *)msg.content.ptr;
+        payload = gnrc_pktbuf_add(NULL, pkt->data, pkt->size,
+                                  GNRC_NETTYPE_UNDEF);
+        gnrc_pktbuf_release(pkt);
+        if (payload != NULL) {
+            _send(payload, SERVER_PORT, CLIENT_PORT);
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t entry;
+    uint32_t start, time, min = UINT32_MAX, max = 0, sum = 0;
+    unsigned sent, received;
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    puts("UDP echo benchmark (single stack thread)");
+#else
+    puts("UDP echo benchmark (thread per layer)");
+#endif
+
+    msg_init_queue(main_queue, QUEUE_SIZE);
+    entry.demux_ctx = CLIENT_PORT;
+    entry.pid = thread_getpid();
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+
+    thread_create(server_stack, sizeof(server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, server, NULL, "server");
+
+    /* latency: one packet in flight */
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        start = xtimer_now();
+        if ((_send_request() < 0) || (_wait_reply() < 0)) {
+            printf("error: round %u got lost\n", i);
+            return 1;
+        }
+        time = xtimer_now() - start;
+        sum += time;
+        if (time < min) {
+            min = time;
+        }
+        if (time > max) {
+            max = time;
+        }
+    }
+    printf("+ round trip: avg %" PRIu32 " us, min %" PRIu32 " us, max %" PRIu32
+           " us\n", sum / ROUNDS, min, max);
+
+    /* throughput: keep WINDOW packets in flight */
+    start = xtimer_now();
+    for (sent = 0; sent < WINDOW; sent++) {
+        if (_send_request() < 0) {
+            puts("error: unable to send");
+            return 1;
+        }
+    }
+    for (received = 0; received < ROUNDS; received++) {
+        if (_wait_reply() < 0) {
+            printf("error: lost %u packets\n", sent - received);
+            return 1;
+        }
+        if ((sent < ROUNDS) && (_send_request() == 0)) {
+            sent++;
+        }
+    }
+    time = xtimer_now() - start;
+    printf("+ throughput: %u packets in %" PRIu32 " us (%" PRIu32 " packets/s)\n",
+           ROUNDS, time, (uint32_t)(((uint64_t)ROUNDS * SEC_IN_USEC) / time));
+
+    puts("Test successful.");
+    return 0;
+}
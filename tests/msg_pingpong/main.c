@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Bounces messages between two threads and measures the number
+ *              of context switches per second
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef ROUNDS
+#define ROUNDS          (10000U)
+#endif
+
+static char pong_stack[THREAD_STACKSIZE_MAIN];
+
+static void *pong(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+
+    while (1) {
+        msg_receive(&msg);
+        msg.content.value++;
+        msg_reply(&msg, &msg);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t req, resp;
+    kernel_pid_t pong_pid;
+    uint32_t start, time;
+
+    puts("msg ping-pong benchmark");
+
+    pong_pid = thread_create(pong_stack, sizeof(pong_stack),
+                             THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                             pong, NULL, "pong");
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        req.content.value = i;
+        msg_send_receive(&req, &resp, pong_pid);
+        if (resp.content.value != (i + 1)) {
+            printf("error: round %u got %" PRIu32 "\n", i, resp.content.value);
+            return 1;
+        }
+    }
+    time = xtimer_now() - start;
+
+    /* every round switches to the pong thread and back */
+    printf("+ switches: %u in %" PRIu32 " us (%" PRIu32 " per second)\n",
+           2 * ROUNDS, time,
+           (uint32_t)(((uint64_t)2 * ROUNDS * SEC_IN_USEC) / (time ? time : 1)));
+
+    puts("Test successful.");
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares msg_send_bulk()/msg_receive_bulk() against sending
+ *              and receiving message by message.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION_S
+#define TEST_DURATION_S     (1U)
+#endif
+
+#define BURST_SIZE          (8U)
+#define RCV_QUEUE_SIZE      (16U)
+
+static char rcv_stack[THREAD_STACKSIZE_MAIN];
+static msg_t rcv_queue[RCV_QUEUE_SIZE];
+static kernel_pid_t rcv_pid;
+
+static volatile int bulk_mode;
+static volatile uint32_t received;
+static volatile uint32_t expected;
+static volatile int failed;
+
+static void _check(const msg_t *m)
+{
+    if (m->content.value != expected) {
+        failed = 1;
+    }
+    expected = m->content.value + 1;
+    received++;
+}
+
+static void *rcv(void *arg)
+{
+    msg_t msgs[BURST_SIZE];
+
+    (void)arg;
+    msg_init_queue(rcv_queue, RCV_QUEUE_SIZE);
+    while (1) {
+        if (bulk_mode) {
+            int n = msg_receive_bulk(msgs, BURST_SIZE);
+            for (int i = 0; i < n; i++) {
+                _check(&msgs[i]);
+            }
+        }
+        else {
+            msg_receive(&msgs[0]);
+            _check(&msgs[0]);
+        }
+    }
+    return NULL;
+}
+
+static void _timeout_cb(void *arg)
+{
+    *((volatile int *)arg) = 1;
+}
+
+static void run(const char *name, int bulk)
+{
+    volatile int done = 0;
+    msg_t msgs[BURST_SIZE];
+    uint32_t seq = 0;
+    xtimer_t timer = { .callback = _timeout_cb, .arg = (void *)&done };
+
+    bulk_mode = bulk;
+    received = 0;
+    expected = 0;
+
+    xtimer_set(&timer, TEST_DURATION_S * SEC_IN_USEC);
+    while (!done) {
+        for (unsigned i = 0; i < BURST_SIZE; i++) {
+            msgs[i].type = 0;
+            msgs[i].content.value = seq++;
+        }
+        if (bulk) {
+            unsigned sent = 0;
+            while (sent < BURST_SIZE) {
+                sent += msg_send_bulk(&msgs[sent], BURST_SIZE - sent, rcv_pid);
+            }
+        }
+        else {
+            for (unsigned i = 0; i < BURST_SIZE; i++) {
+                msg_send(&msgs[i], rcv_pid);
+            }
+        }
+    }
+
+    printf("+ %s: %" PRIu32 " messages per second\n", name,
+           received / TEST_DURATION_S);
+}
+
+int main(void)
+{
+    puts("msg_send_bulk test application");
+
+    rcv_pid = thread_create(rcv_stack, sizeof(rcv_stack),
+                            THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                            rcv, NULL, "rcv");
+
+    run("single", 0);
+    run("bulk", 1);
+
+    if (failed) {
+        puts("Test failed.");
+    }
+    else {
+        puts("Test successful.");
+    }
+    return 0;
+}
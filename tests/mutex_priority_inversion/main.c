@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures how long a high priority thread waits for a mutex
+ *              held by a low priority thread while a medium priority thread
+ *              hogs the CPU
+ *
+ * Without priority inheritance, the medium priority thread preempts the
+ * holder and the wait includes the complete CPU hog. With the
+ * `core_mutex_pi` module, the holder runs with the waiter's priority and the
+ * wait is bounded by the time the mutex is held.
+ *
+ * In the nested rounds, the holder additionally locks and unlocks a second
+ * mutex while holding the first, which must not drop the inherited priority.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ROUNDS          (5U)
+#define HOLD_TIME       (20U * MS_IN_USEC)  /**< low holds the mutex */
+#define HOG_TIME        (100U * MS_IN_USEC) /**< medium hogs the CPU */
+#define SLICE           (1U * MS_IN_USEC)   /**< granularity of busy loops */
+#define HIGH_DELAY      (5U * MS_IN_USEC)   /**< high starts to wait */
+#define MEDIUM_DELAY    (10U * MS_IN_USEC)  /**< medium starts to hog */
+
+static char low_stack[THREAD_STACKSIZE_MAIN];
+static char medium_stack[THREAD_STACKSIZE_MAIN];
+static char high_stack[THREAD_STACKSIZE_MAIN];
+
+static mutex_t lock = MUTEX_INIT;
+static mutex_t inner = MUTEX_INIT;
+static kernel_pid_t main_pid;
+
+/**
+ * @brief   Burns @p time of CPU time
+ *
+ * Spins in slices, so that time spent preempted counts at most one slice.
+ */
+static void _work(uint32_t time)
+{
+    for (uint32_t i = 0; i < time / SLICE; i++) {
+        xtimer_spin(SLICE);
+    }
+}
+
+static void *low(void *arg)
+{
+    mutex_lock(&lock);
+    if (arg) {
+        mutex_lock(&inner);
+        _work(HOLD_TIME);
+        mutex_unlock(&inner);
+    }
+    _work(HOLD_TIME);
+    mutex_unlock(&lock);
+    return NULL;
+}
+
+static void *medium(void *arg)
+{
+    (void)arg;
+
+    xtimer_usleep(MEDIUM_DELAY);
+    _work(HOG_TIME);
+    return NULL;
+}
+
+static void *high(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+    uint32_t start;
+
+    xtimer_usleep(HIGH_DELAY);
+    start = xtimer_now();
+    mutex_lock(&lock);
+    msg.content.value = xtimer_now() - start;
+    mutex_unlock(&lock);
+
+    msg_send(&msg, main_pid);
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t max_wait = 0;
+
+    puts("Mutex priority inversion test");
+    main_pid = thread_getpid();
+
+    for (unsigned i = 0; i < 2 * ROUNDS; i++) {
+        msg_t msg;
+        int nested = (i >= ROUNDS);
+
+        /* main has the lowest priority, so all threads are done when the
+         * result is received */
+        thread_create(high_stack, sizeof(high_stack), THREAD_PRIORITY_MAIN - 3,
+                      THREAD_CREATE_STACKTEST, high, NULL, "high");
+        thread_create(medium_stack, sizeof(medium_stack),
+                      THREAD_PRIORITY_MAIN - 2, THREAD_CREATE_STACKTEST,
+                      medium, NULL, "medium");
+        thread_create(low_stack, sizeof(low_stack), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, low, (void *)(uintptr_t)nested, "low");
+        msg_receive(&msg);
+
+        printf("round %u%s: high waited %" PRIu32 " us\n", i,
+               nested ? " (nested)" : "", msg.content.value);
+        if (msg.content.value > max_wait) {
+            max_wait = msg.content.value;
+        }
+    }
+
+    printf("+ worst-case wait: %" PRIu32 " us\n", max_wait);
+#ifdef MODULE_CORE_MUTEX_PI
+    if (max_wait >= HOG_TIME) {
+        puts("error: high priority thread waited for medium priority thread");
+        return 1;
+    }
+#else
+    puts("(no priority inheritance, wait includes the medium priority hog)");
+#endif
+
+    puts("Test successful.");
+    return 0;
+}
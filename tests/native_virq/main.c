@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stresses the interrupt handling of the `native_virq` module
+ *
+ * Several threads wake up periodically on xtimer while two threads bounce
+ * messages as fast as possible, so timer signals arrive at any point of a
+ * context switch, including while queued signals are dispatched. A lost
+ * signal shows up as a late wakeup or makes the final sleeps hang.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TICKERS         (4U)
+#define DURATION        (2U * SEC_IN_USEC)
+#define MAX_LATE        (100U * MS_IN_USEC)
+#define QUIET_SLEEPS    (100U)
+#define QUIET_SLEEP     (1U * MS_IN_USEC)
+
+static const uint32_t intervals[TICKERS] = { 1000, 1500, 2300, 3100 };
+
+static char ticker_stacks[TICKERS][THREAD_STACKSIZE_DEFAULT];
+static char ping_stack[THREAD_STACKSIZE_DEFAULT];
+static char pong_stack[THREAD_STACKSIZE_DEFAULT];
+
+static kernel_pid_t main_pid;
+static kernel_pid_t pong_pid;
+static volatile int done;
+
+static void *ticker(void *arg)
+{
+    uint32_t interval = intervals[(uintptr_t)arg];
+    uint32_t last = xtimer_now();
+    uint32_t start = last;
+    uint32_t max_late = 0;
+    msg_t msg;
+
+    while ((last - start) < DURATION) {
+        xtimer_usleep_until(&last, interval);
+        uint32_t late = xtimer_now() - last;
+        if (late > max_late) {
+            max_late = late;
+        }
+    }
+
+    msg.type = (uintptr_t)arg;
+    msg.content.value = max_late;
+    msg_send(&msg, main_pid);
+    return NULL;
+}
+
+static void *pong(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+
+    while (1) {
+        msg_receive(&msg);
+        msg.content.value++;
+        msg_reply(&msg, &msg);
+    }
+
+    return NULL;
+}
+
+static void *ping(void *arg)
+{
+    (void)arg;
+    msg_t req, resp;
+    uint32_t i = 0;
+
+    while (!done) {
+        req.content.value = i;
+        msg_send_receive(&req, &resp, pong_pid);
+        if (resp.content.value != (i + 1)) {
+            printf("error: ping %" PRIu32 " got %" PRIu32 "\n", i,
+                   resp.content.value);
+            break;
+        }
+        i++;
+    }
+
+    req.type = TICKERS;
+    req.content.value = i;
+    msg_send(&req, main_pid);
+    return NULL;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    puts("native_virq interrupt stress test");
+    main_pid = thread_getpid();
+
+    /* the message bouncing threads only run while the others sleep */
+    pong_pid = thread_create(pong_stack, sizeof(pong_stack),
+                             THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST,
+                             pong, NULL, "pong");
+    thread_create(ping_stack, sizeof(ping_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, ping, NULL, "ping");
+    for (unsigned i = 0; i < TICKERS; i++) {
+        thread_create(ticker_stacks[i], sizeof(ticker_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                      ticker, (void *)(uintptr_t)i, "ticker");
+    }
+
+    for (unsigned i = 0; i < TICKERS; i++) {
+        msg_t msg;
+        msg_receive(&msg);
+        printf("ticker %u (%" PRIu32 " us): late by max %" PRIu32 " us\n",
+               (unsigned)msg.type, intervals[msg.type], msg.content.value);
+        if (msg.content.value > MAX_LATE) {
+            failed = 1;
+        }
+    }
+
+    done = 1;
+    msg_t msg;
+    msg_receive(&msg);
+    printf("ping-pong rounds: %" PRIu32 "\n", msg.content.value);
+
+    /* nothing else runs now, a signal stuck in the queue hangs here */
+    for (unsigned i = 0; i < QUIET_SLEEPS; i++) {
+        xtimer_usleep(QUIET_SLEEP);
+    }
+
+    if (failed) {
+        puts("error: a wakeup was late");
+        return 1;
+    }
+    puts("Test successful.");
+    return 0;
+}
@@ -35,6 +35,10 @@
 
 #define _MAIN_MSG_QUEUE_SIZE (2)
 
+#define _STORM_STACKSIZE    (THREAD_STACKSIZE_DEFAULT)
+#define _STORM_PRIO         (_MAC_PRIO - 1)
+#define _STORM_IRQS         (64U)   /**< more than fit into the MAC's queue */
+
 #define _TEST_PAYLOAD1  "gO3Xt,fP)6* MR161Auk?W^mTb\"LmY^Qc5w1h:C<+n(*/@4k("
 #define _TEST_PAYLOAD2  "*b/'XKkraEBexaU\\O-X&<Bl'n%35Ll+nDy,jQ+[Oe4:9( 4cI"
 
@@ -59,8 +63,23 @@ static msg_t _main_msg_queue[_MAIN_MSG_QUEUE_SIZE];
 static uint8_t _tmp[_EXP_LENGTH];
 static kernel_pid_t _mac_pid;
 static uint8_t _tmp_len = 0;
+static char _storm_stack[_STORM_STACKSIZE];
+static unsigned _storm_pending = 0;
+static unsigned _storm_handled = 0;
 
 static void _dev_isr(netdev2_t *dev);
+static void _dev_isr_storm(netdev2_t *dev);
+static void _dev_isr_storm(netdev2_t *dev)
+{
+    /* like a level triggered interrupt line, the device keeps firing as
+     * long as there are events left */
+    _storm_pending--;
+    _storm_handled++;
+    if (_storm_pending > 0) {
+        dev->event_callback(dev, NETDEV2_EVENT_ISR, dev->isr_arg);
+    }
+}
+
 static int _dev_recv(netdev2_t *dev, char *buf, int len, void *info);
 static int _dev_send(netdev2_t *dev, const struct iovec *vector, int count);
 static int _dev_get_addr(netdev2_t *dev, void *value, size_t max_len);
@@ -255,6 +274,36 @@ static int test_set_addr(void)
     return 1;
 }
 
+static void *_storm(void *arg)
+{
+    (void)arg;
+    /* runs with higher priority than the MAC thread, so it can not handle
+     * any of the interrupts before the storm is over */
+    for (unsigned i = 0; i < _STORM_IRQS; i++) {
+        _storm_pending++;
+        _dev.netdev.event_callback((netdev2_t *)&_dev.netdev, NETDEV2_EVENT_ISR,
+                                   &_dev.netdev.isr_arg);
+    }
+    return NULL;
+}
+
+/* tests that no interrupt gets lost when they fire faster than handled */
+static int test_irq_storm(void)
+{
+    netdev2_test_set_isr_cb(&_dev, _dev_isr_storm);
+    /* the MAC thread has a higher priority than main, so it handled all
+     * interrupts when thread_create() returns */
+    thread_create(_storm_stack, sizeof(_storm_stack), _STORM_PRIO,
+                  THREAD_CREATE_STACKTEST, _storm, NULL, "irq_storm");
+    netdev2_test_set_isr_cb(&_dev, _dev_isr);
+    if ((_storm_pending != 0) || (_storm_handled != _STORM_IRQS)) {
+        printf("Lost interrupts: %u of %u handled\n", _storm_handled,
+               _STORM_IRQS);
+        return 0;
+    }
+    return 1;
+}
+
 int main(void)
 {
     /* initialization */
@@ -279,6 +328,7 @@ int main(void)
     EXECUTE(test_send);
     EXECUTE(test_receive);
     EXECUTE(test_set_addr);
+    EXECUTE(test_irq_storm);
     puts("ALL TESTS SUCCESSFUL");
 
     return 0;
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Pushes bytes through tsrb and ringbuffer and measures the
+ *              throughput of byte wise, bulk and span based access
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "ringbuffer.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#ifndef BYTES
+#define BYTES           (262144U)
+#endif
+
+#define BUF_SIZE        (256U)
+#define CHUNK_SIZE      (48U)   /**< not a divider of BUF_SIZE to get wrap arounds */
+
+static char buf[BUF_SIZE];
+static char chunk[CHUNK_SIZE];
+static char out[CHUNK_SIZE];
+
+static tsrb_t tsrb;
+static ringbuffer_t rb;
+
+static uint32_t checksum;
+
+static void _print(const char *name, uint32_t time)
+{
+    if (time == 0) {
+        time = 1;
+    }
+    printf("+ %-20s %8" PRIu32 " us, %8" PRIu32 " kB/s\n", name, time,
+           (uint32_t)(((uint64_t)BYTES * SEC_IN_USEC) / (time * 1024U)));
+}
+
+static void _consume(const char *data, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        checksum += (unsigned char)data[i];
+    }
+}
+
+static uint32_t _tsrb_bytewise(void)
+{
+    uint32_t start = xtimer_now();
+
+    tsrb_init(&tsrb, buf, sizeof(buf));
+    for (unsigned done = 0; done < BYTES; done += CHUNK_SIZE) {
+        for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+            tsrb_add_one(&tsrb, chunk[i]);
+        }
+        for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+            out[i] = tsrb_get_one(&tsrb);
+        }
+        _consume(out, CHUNK_SIZE);
+    }
+    return xtimer_now() - start;
+}
+
+static uint32_t _tsrb_bulk(void)
+{
+    uint32_t start = xtimer_now();
+
+    tsrb_init(&tsrb, buf, sizeof(buf));
+    for (unsigned done = 0; done < BYTES; done += CHUNK_SIZE) {
+        tsrb_add(&tsrb, chunk, CHUNK_SIZE);
+        tsrb_get(&tsrb, out, CHUNK_SIZE);
+        _consume(out, CHUNK_SIZE);
+    }
+    return xtimer_now() - start;
+}
+
+static uint32_t _tsrb_span(void)
+{
+    uint32_t start = xtimer_now();
+
+    tsrb_init(&tsrb, buf, sizeof(buf));
+    for (unsigned done = 0; done < BYTES; done += CHUNK_SIZE) {
+        tsrb_span_t span[2];
+
+        tsrb_add(&tsrb, chunk, CHUNK_SIZE);
+        /* consume in place instead of copying out */
+        tsrb_peek_span(&tsrb, span);
+        _consume(span[0].buf, span[0].len);
+        _consume(span[1].buf, span[1].len);
+        tsrb_drop(&tsrb, span[0].len + span[1].len);
+    }
+    return xtimer_now() - start;
+}
+
+static uint32_t _ringbuffer_bytewise(void)
+{
+    uint32_t start = xtimer_now();
+
+    ringbuffer_init(&rb, buf, sizeof(buf));
+    for (unsigned done = 0; done < BYTES; done += CHUNK_SIZE) {
+        for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+            ringbuffer_add_one(&rb, chunk[i]);
+        }
+        for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+            out[i] = ringbuffer_get_one(&rb);
+        }
+        _consume(out, CHUNK_SIZE);
+    }
+    return xtimer_now() - start;
+}
+
+static uint32_t _ringbuffer_bulk(void)
+{
+    uint32_t start = xtimer_now();
+
+    ringbuffer_init(&rb, buf, sizeof(buf));
+    for (unsigned done = 0; done < BYTES; done += CHUNK_SIZE) {
+        ringbuffer_add(&rb, chunk, CHUNK_SIZE);
+        ringbuffer_get(&rb, out, CHUNK_SIZE);
+        _consume(out, CHUNK_SIZE);
+    }
+    return xtimer_now() - start;
+}
+
+static uint32_t _ringbuffer_span(void)
+{
+    uint32_t start = xtimer_now();
+
+    ringbuffer_init(&rb, buf, sizeof(buf));
+    for (unsigned done = 0; done < BYTES; done += CHUNK_SIZE) {
+        ringbuffer_span_t span[2];
+
+        ringbuffer_add(&rb, chunk, CHUNK_SIZE);
+        ringbuffer_peek_span(&rb, span);
+        _consume(span[0].buf, span[0].len);
+        _consume(span[1].buf, span[1].len);
+        ringbuffer_remove(&rb, span[0].len + span[1].len);
+    }
+    return xtimer_now() - start;
+}
+
+static const struct {
+    const char *name;
+    uint32_t (*run)(void);
+} variants[] = {
+    { "tsrb bulk", _tsrb_bulk },
+    { "tsrb span", _tsrb_span },
+    { "ringbuffer bytewise", _ringbuffer_bytewise },
+    { "ringbuffer bulk", _ringbuffer_bulk },
+    { "ringbuffer span", _ringbuffer_span },
+};
+
+int main(void)
+{
+    uint32_t expected;
+
+    puts("ringbuffer throughput benchmark");
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        chunk[i] = (char)i;
+    }
+
+    /* all variants have to see the same bytes */
+    checksum = 0;
+    _print("tsrb bytewise", _tsrb_bytewise());
+    expected = checksum;
+
+    for (unsigned i = 0; i < sizeof(variants) / sizeof(variants[0]); i++) {
+        checksum = 0;
+        _print(variants[i].name, variants[i].run());
+        if (checksum != expected) {
+            printf("error: %s corrupted the data\n", variants[i].name);
+            return 1;
+        }
+    }
+
+    puts("Test successful.");
+    return 0;
+}
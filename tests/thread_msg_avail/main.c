@@ -46,6 +46,23 @@ int main(void)
             ; /* spin forever if we don't have the result we expect */
     }
 
+#ifdef MODULE_CORE_MSG_STATS
+    msg_t overflow;
+    msg_stats_t stats;
+
+    /* the queue is full, so this one gets dropped */
+    if (msg_send_to_self(&overflow) != 0) {
+        puts("error: message queued to full queue");
+    }
+    msg_stats_get(thread_getpid(), &stats);
+    printf("msg stats: queued %" PRIu32 ", dropped %" PRIu32 ", hwm %u\n",
+           stats.queued, stats.dropped, (unsigned)stats.queue_hwm);
+    if ((stats.queued != MSG_QUEUE_LENGTH) || (stats.dropped != 1) ||
+        (stats.queue_hwm != MSG_QUEUE_LENGTH)) {
+        puts("error: unexpected msg stats");
+    }
+#endif
+
     for (int idx = msg_avail(); idx > 0; --idx) {
         msg_t msg;
         msg_receive(&msg);
@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include "thread.h"
 #include "msg.h"
@@ -64,5 +65,19 @@ int main(void)
     msg_receive(&msg);
 
     printf("MAIN THREAD %" PRIkernel_pid " ALIVE!\n", p_main);
+
+#ifdef MODULE_CORE_MSG_STATS
+    /* the first message is handed over directly, the sender of the second one
+     * blocks as there is no queue */
+    msg_stats_t stats;
+    msg_stats_get(p_main, &stats);
+    printf("msg stats: queued %" PRIu32 ", direct %" PRIu32 ", dropped %" PRIu32
+           ", blocked %" PRIu32 ", hwm %u\n", stats.queued, stats.direct,
+           stats.dropped, stats.send_blocked, (unsigned)stats.queue_hwm);
+    if ((stats.queued != 0) || (stats.direct != 1) || (stats.dropped != 0) ||
+        (stats.send_blocked != 1) || (stats.queue_hwm != 0)) {
+        puts("error: unexpected msg stats");
+    }
+#endif
     return 0;
 }
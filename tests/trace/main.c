@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Records a trace of messages, mutex contention and timers and
+ *              checks that all event types show up
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "trace.h"
+#include "xtimer.h"
+
+#define ROUNDS          (4U)
+
+static char worker_stack[THREAD_STACKSIZE_MAIN];
+static mutex_t lock = MUTEX_INIT;
+static trace_event_t events[TRACE_BUFSIZE];
+
+static void *worker(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+
+    while (1) {
+        msg_receive(&msg);
+        /* main holds the lock, so this blocks until main unlocks it */
+        mutex_lock(&lock);
+        mutex_unlock(&lock);
+        msg_send(&msg, msg.sender_pid);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    unsigned seen[TRACE_USER + 1] = { 0 };
+    kernel_pid_t pid;
+    unsigned numof;
+
+    puts("kernel event tracer test");
+
+    pid = thread_create(worker_stack, sizeof(worker_stack),
+                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                        worker, NULL, "worker");
+
+    trace_start();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        msg_t msg = { .content.value = i };
+
+        mutex_lock(&lock);
+        msg_send(&msg, pid);
+        xtimer_usleep(1000);
+        mutex_unlock(&lock);
+        msg_receive(&msg);
+    }
+    trace_event(TRACE_USER, 0x2a);
+    trace_stop();
+
+    numof = trace_read(events, TRACE_BUFSIZE);
+    for (unsigned i = 0; i < numof; i++) {
+        if (events[i].type <= TRACE_USER) {
+            seen[events[i].type]++;
+        }
+        if ((i > 0) && ((int32_t)(events[i].time - events[i - 1].time) < 0)) {
+            printf("error: event %u recorded before its predecessor\n", i);
+            return 1;
+        }
+    }
+    trace_dump();
+
+    if (!seen[TRACE_SCHED] || !seen[TRACE_MSG_SEND] ||
+        !seen[TRACE_MSG_RECEIVE] || (seen[TRACE_MUTEX_BLOCK] != ROUNDS) ||
+        (seen[TRACE_MUTEX_UNBLOCK] != ROUNDS) || !seen[TRACE_XTIMER_FIRE] ||
+        (seen[TRACE_USER] != 1)) {
+        puts("error: event missing");
+        return 1;
+    }
+
+    puts("Test successful.");
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2016 agent <agent@local>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+def testfunc(child):
+    child.expect(r"TRACE T \d+ worker")
+    child.expect(r"TRACE E \d+ \d+ 8 2a")
+    child.expect(u"Test successful.")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -114,10 +116,54 @@ static void tests_core_ringbuffer(void)
     run_add();
 }
 
+static void tests_core_ringbuffer_span(void)
+{
+    ringbuffer_span_t span[2];
+    char out[BUF_SIZE];
+
+    ringbuffer_init(&rb, rb_buf, sizeof(rb_buf));
+
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, ringbuffer_write_span(&rb, span));
+    TEST_ASSERT(span[0].buf == rb_buf);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, span[0].len);
+    TEST_ASSERT_EQUAL_INT(0, span[1].len);
+
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_add(&rb, "abcde", 5));
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&rb, 3));
+    assert_get_one('d');
+
+    /* free space wraps around the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(6, ringbuffer_write_span(&rb, span));
+    TEST_ASSERT(span[0].buf == &rb_buf[5]);
+    TEST_ASSERT_EQUAL_INT(2, span[0].len);
+    TEST_ASSERT(span[1].buf == rb_buf);
+    TEST_ASSERT_EQUAL_INT(4, span[1].len);
+    memcpy(span[0].buf, "fg", 2);
+    memcpy(span[1].buf, "hij", 3);
+    ringbuffer_commit(&rb, 5);
+    assert_avail(6);
+
+    /* so do the elements */
+    TEST_ASSERT_EQUAL_INT(6, ringbuffer_peek_span(&rb, span));
+    TEST_ASSERT_EQUAL_INT(3, span[0].len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span[0].buf, "efg", 3));
+    TEST_ASSERT_EQUAL_INT(3, span[1].len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span[1].buf, "hij", 3));
+    assert_avail(6);
+
+    /* adding more than fits does not overwrite anything */
+    TEST_ASSERT_EQUAL_INT(1, ringbuffer_add(&rb, "kl", 2));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, ringbuffer_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "efghijk", BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_peek_span(&rb, span));
+    TEST_ASSERT_EQUAL_INT(0, span[0].len + span[1].len);
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
+        new_TestFixture(tests_core_ringbuffer_span),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -21,11 +21,35 @@
 
 #define TEST_FIB_TABLE_SIZE (20)
 static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+#ifdef MODULE_FIB_TRIE
+static fib_trie_node_t _trie_nodes[FIB_TRIE_NODES_NUMOF(TEST_FIB_TABLE_SIZE)];
+#endif
 static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .table_type = FIB_TABLE_TYPE_SH,
                                       .size = TEST_FIB_TABLE_SIZE,
                                       .mtx_access = MUTEX_INIT,
-                                      .notify_rp_pos = 0 };
+                                      .notify_rp_pos = 0,
+#ifdef MODULE_FIB_TRIE
+                                      .trie_nodes = _trie_nodes,
+#endif
+                                    };
+
+#define TEST_FIB_BENCH_TABLE_SIZE   (128)
+#define TEST_FIB_BENCH_NEXT_HOPS    (4)
+#define TEST_FIB_BENCH_LOOKUPS      (10000)
+static fib_entry_t _bench_entries[TEST_FIB_BENCH_TABLE_SIZE];
+#ifdef MODULE_FIB_TRIE
+static fib_trie_node_t _bench_trie_nodes[FIB_TRIE_NODES_NUMOF(TEST_FIB_BENCH_TABLE_SIZE)];
+#endif
+static fib_table_t test_fib_bench_table = { .data.entries = _bench_entries,
+                                            .table_type = FIB_TABLE_TYPE_SH,
+                                            .size = TEST_FIB_BENCH_TABLE_SIZE,
+                                            .mtx_access = MUTEX_INIT,
+                                            .notify_rp_pos = 0,
+#ifdef MODULE_FIB_TRIE
+                                            .trie_nodes = _bench_trie_nodes,
+#endif
+                                          };
 
 /*
 * @brief helper to fill FIB with unique entries
@@ -976,6 +1000,128 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief helper to construct a 2001:db8:<idx>::<host>/48 style address
+*/
+static void _bench_addr(uint8_t *addr, uint16_t idx, uint16_t host)
+{
+    memset(addr, 0, 16);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[4] = (uint8_t)(idx >> 8);
+    addr[5] = (uint8_t)idx;
+    addr[14] = (uint8_t)(host >> 8);
+    addr[15] = (uint8_t)host;
+}
+
+/*
+* @brief longest prefix matching on a large table (and a default route)
+* It is expected to find the next hop of the matching /48 prefix for each
+* destination and to fall back to the default route for other destinations.
+* The time spent for the lookups is printed.
+*/
+static void test_fib_21_large_table_lookup(void)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    uint8_t addr_default[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    uint32_t start, duration;
+
+    fib_init(&test_fib_bench_table);
+    memset(addr_default, 0, add_buf_size);
+
+    /* the default route takes one entry, next hops are ::1 to ::4 */
+    _bench_addr(addr_nxt, 0, TEST_FIB_BENCH_NEXT_HOPS + 1);
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_bench_table, 42,
+                                           addr_default, add_buf_size, 0x0,
+                                           addr_nxt, add_buf_size, 0x0,
+                                           FIB_LIFETIME_NO_EXPIRE));
+    for (uint16_t i = 1; i < TEST_FIB_BENCH_TABLE_SIZE; ++i) {
+        _bench_addr(addr_dst, i, 0);
+        _bench_addr(addr_nxt, 0, 1 + (i % TEST_FIB_BENCH_NEXT_HOPS));
+        TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_bench_table, 42,
+                                               addr_dst, add_buf_size,
+                                               (48 << FIB_FLAG_NET_PREFIX_SHIFT),
+                                               addr_nxt, add_buf_size, 0x0,
+                                               100000));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_FIB_BENCH_TABLE_SIZE,
+                          fib_get_num_used_entries(&test_fib_bench_table));
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < TEST_FIB_BENCH_LOOKUPS; ++i) {
+        /* every 16th destination is not covered by the /48 prefixes */
+        uint16_t idx = (i & 0xf) ? 1 + (i % (TEST_FIB_BENCH_TABLE_SIZE - 1))
+                                 : TEST_FIB_BENCH_TABLE_SIZE + i;
+        uint16_t expected = (i & 0xf) ? 1 + (idx % TEST_FIB_BENCH_NEXT_HOPS)
+                                      : TEST_FIB_BENCH_NEXT_HOPS + 1;
+
+        _bench_addr(addr_dst, idx, (uint16_t)i | 1);
+        add_buf_size = 16;
+        TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_bench_table,
+                                                  &iface_id, addr_nxt,
+                                                  &add_buf_size, &next_hop_flags,
+                                                  addr_dst, add_buf_size, 0x0));
+        TEST_ASSERT_EQUAL_INT(expected, addr_nxt[15]);
+    }
+    duration = xtimer_now() - start;
+
+    printf("\n[fib] %u lookups in a table of %u entries took %lu us\n",
+           (unsigned)TEST_FIB_BENCH_LOOKUPS, (unsigned)TEST_FIB_BENCH_TABLE_SIZE,
+           (unsigned long)duration);
+
+    fib_deinit(&test_fib_bench_table);
+}
+
+/*
+* @brief adding, updating and removing entries changes the generation of the
+* table, looking them up does not
+*/
+static void test_fib_22_generation(void)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    uint8_t addr_nxt_hop[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    uint32_t generation = test_fib_table.generation;
+
+    memset(addr_dst, 0x11, add_buf_size);
+    memset(addr_nxt, 0x22, add_buf_size);
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42,
+                                           addr_dst, add_buf_size, 0x0,
+                                           addr_nxt, add_buf_size, 0x0,
+                                           FIB_LIFETIME_NO_EXPIRE));
+    TEST_ASSERT(generation != test_fib_table.generation);
+
+    generation = test_fib_table.generation;
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                                              addr_nxt_hop, &add_buf_size,
+                                              &next_hop_flags, addr_dst,
+                                              add_buf_size, 0x0));
+    TEST_ASSERT_EQUAL_INT(generation, test_fib_table.generation);
+
+    memset(addr_nxt, 0x33, add_buf_size);
+    TEST_ASSERT_EQUAL_INT(0, fib_update_entry(&test_fib_table,
+                                              addr_dst, add_buf_size,
+                                              addr_nxt, add_buf_size, 0x0,
+                                              FIB_LIFETIME_NO_EXPIRE));
+    TEST_ASSERT(generation != test_fib_table.generation);
+
+    generation = test_fib_table.generation;
+    fib_remove_entry(&test_fib_table, addr_dst, add_buf_size);
+    TEST_ASSERT(generation != test_fib_table.generation);
+
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1146,8 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_large_table_lookup),
+                        new_TestFixture(test_fib_22_generation),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
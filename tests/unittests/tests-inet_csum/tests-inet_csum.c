@@ -12,11 +12,14 @@
  * @file
  */
 #include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
 #include "net/inet_csum.h"
+#include "xtimer.h"
 
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
@@ -165,6 +168,127 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+#define RANDOM_BUF_SIZE     (1280U)
+#define RANDOM_RUNS         (500U)
+#define BENCH_RUNS          (1000U)
+
+static uint8_t random_buf[RANDOM_BUF_SIZE + 8];
+static uint32_t random_state = 0x2a2a2a2a;
+
+static uint32_t _random(void)
+{
+    /* xorshift32, so runs are reproducible */
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/* reference: byte-wise implementation inet_csum_slice() was derived from */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (int i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        uint16_t carry = csum >> 16;
+        csum = (csum & 0xffff) + carry;
+    }
+    return csum;
+}
+
+static void test_inet_csum__random_equivalence(void)
+{
+    for (unsigned i = 0; i < sizeof(random_buf); i++) {
+        random_buf[i] = _random();
+    }
+
+    for (unsigned i = 0; i < RANDOM_RUNS; i++) {
+        /* random start alignment, length, initial sum and accumulated length */
+        const uint8_t *buf = &random_buf[_random() % 8];
+        uint16_t len = _random() % (RANDOM_BUF_SIZE + 1);
+        uint16_t sum = _random();
+        size_t accum_len = _random() % 64;
+
+        TEST_ASSERT_EQUAL_INT(_ref_csum_slice(sum, buf, len, accum_len),
+                              inet_csum_slice(sum, buf, len, accum_len));
+    }
+}
+
+static void test_inet_csum__random_slices(void)
+{
+    for (unsigned i = 0; i < RANDOM_RUNS; i++) {
+        /* checksum over a random split of the buffer into up to four slices */
+        const uint8_t *buf = &random_buf[_random() % 8];
+        uint16_t len = _random() % (RANDOM_BUF_SIZE + 1);
+        uint16_t expected = _ref_csum_slice(0, buf, len, 0);
+        uint16_t sum = 0;
+        size_t accum_len = 0;
+
+        while (accum_len < len) {
+            uint16_t slice_len = (_random() % (len - accum_len)) + 1;
+
+            sum = inet_csum_slice(sum, &buf[accum_len], slice_len, accum_len);
+            accum_len += slice_len;
+        }
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
+static void test_inet_csum__all_ones(void)
+{
+    /* many maximum words need several wrap-arounds */
+    memset(random_buf, 0xff, sizeof(random_buf));
+    for (unsigned i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0xffff, &random_buf[i], RANDOM_BUF_SIZE, 0),
+                              inet_csum_slice(0xffff, &random_buf[i], RANDOM_BUF_SIZE, 0));
+        TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0, &random_buf[i], RANDOM_BUF_SIZE - 1, 1),
+                              inet_csum_slice(0, &random_buf[i], RANDOM_BUF_SIZE - 1, 1));
+    }
+}
+
+static void test_inet_csum__benchmark(void)
+{
+    uint32_t start, ref_time, time;
+    uint16_t ref_sum = 0, sum = 0;
+
+    for (unsigned i = 0; i < sizeof(random_buf); i++) {
+        random_buf[i] = _random();
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        ref_sum = _ref_csum_slice(ref_sum, random_buf, RANDOM_BUF_SIZE, 0);
+    }
+    ref_time = xtimer_now() - start;
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        sum = inet_csum_slice(sum, random_buf, RANDOM_BUF_SIZE, 0);
+    }
+    time = xtimer_now() - start;
+
+    TEST_ASSERT_EQUAL_INT(ref_sum, sum);
+    printf("\n[inet_csum] %u x %u bytes: byte-wise %lu us, inet_csum_slice() %lu us\n",
+           BENCH_RUNS, RANDOM_BUF_SIZE, (unsigned long)ref_time,
+           (unsigned long)time);
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +300,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__random_equivalence),
+        new_TestFixture(test_inet_csum__random_slices),
+        new_TestFixture(test_inet_csum__all_ones),
+        new_TestFixture(test_inet_csum__benchmark),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ *
+ * @author      agent <agent@local>
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/dc.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "xtimer.h"
+
+#include "unittests-constants.h"
+#include "tests-ipv6_dc.h"
+
+/* default interface for testing */
+#define DEFAULT_TEST_NETIF      (TEST_UINT16)
+/* another interface for testing */
+#define OTHER_TEST_NETIF        (TEST_UINT16 + TEST_UINT8)
+/* default destination for testing */
+#define DEFAULT_TEST_DST        { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 \
+        } \
+    }
+/* source address for testing */
+#define DEFAULT_TEST_SRC        { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 \
+        } \
+    }
+/* next hop for testing */
+#define DEFAULT_TEST_NEXT_HOP   { { \
+            0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03 \
+        } \
+    }
+#define DEFAULT_TEST_L2_ADDR    (TEST_STRING8)
+#define DEFAULT_TEST_L2_ADDR_LEN    (8U)
+
+static void set_up(void)
+{
+    gnrc_ipv6_dc_init();
+    gnrc_ipv6_netif_add(DEFAULT_TEST_NETIF);
+}
+
+static void tear_down(void)
+{
+    gnrc_ipv6_dc_init();
+    gnrc_ipv6_nc_init();
+    gnrc_ipv6_netif_init();
+}
+
+static gnrc_ipv6_dc_t *_add(kernel_pid_t req_iface, const ipv6_addr_t *dst)
+{
+    ipv6_addr_t src = DEFAULT_TEST_SRC;
+
+    /* entries are added after a failed lookup */
+    gnrc_ipv6_dc_get(req_iface, dst);
+    return gnrc_ipv6_dc_add(req_iface, dst, &src, DEFAULT_TEST_NETIF,
+                            (uint8_t *)DEFAULT_TEST_L2_ADDR,
+                            DEFAULT_TEST_L2_ADDR_LEN);
+}
+
+static void test_ipv6_dc_get__empty(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST;
+
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dc_get__success(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST, src = DEFAULT_TEST_SRC;
+    gnrc_ipv6_dc_t *entry;
+
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst)));
+    TEST_ASSERT(ipv6_addr_equal(&dst, &entry->dst));
+    TEST_ASSERT(ipv6_addr_equal(&src, &entry->src));
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_NETIF, entry->iface);
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_L2_ADDR_LEN, entry->l2_addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(DEFAULT_TEST_L2_ADDR, entry->l2_addr,
+                                    DEFAULT_TEST_L2_ADDR_LEN));
+}
+
+static void test_ipv6_dc_get__different_if(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(OTHER_TEST_NETIF, &dst));
+}
+
+static void test_ipv6_dc_get__expired(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    xtimer_usleep(GNRC_IPV6_DC_LIFETIME);
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dc_add__no_src(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST;
+    gnrc_ipv6_dc_t *entry;
+
+    gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst);
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_dc_add(KERNEL_PID_UNDEF, &dst, NULL,
+                                                   DEFAULT_TEST_NETIF,
+                                                   (uint8_t *)DEFAULT_TEST_L2_ADDR,
+                                                   0)));
+    TEST_ASSERT(ipv6_addr_is_unspecified(&entry->src));
+    TEST_ASSERT_EQUAL_INT(0, entry->l2_addr_len);
+}
+
+static void test_ipv6_dc_add__update(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST;
+    gnrc_ipv6_dc_t *entry1, *entry2;
+
+    TEST_ASSERT_NOT_NULL((entry1 = _add(KERNEL_PID_UNDEF, &dst)));
+    TEST_ASSERT_NOT_NULL((entry2 = _add(KERNEL_PID_UNDEF, &dst)));
+    TEST_ASSERT(entry1 == entry2);
+}
+
+static void test_ipv6_dc_add__full_replace_oldest(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST;
+
+    for (unsigned i = 0; i <= GNRC_IPV6_DC_SIZE; i++) {
+        dst.u8[15] = i;
+        TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    }
+    dst.u8[15] = 0;
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+    for (unsigned i = 1; i <= GNRC_IPV6_DC_SIZE; i++) {
+        dst.u8[15] = i;
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+    }
+}
+
+static void test_ipv6_dc_invalidate__success(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_dc_invalidate();
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+    /* entries of the new generation are valid again */
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dc_invalidate__during_lookup(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST, src = DEFAULT_TEST_SRC;
+
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+    /* information the next hop was determined from changed in between */
+    gnrc_ipv6_dc_invalidate();
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dc_add(KERNEL_PID_UNDEF, &dst, &src,
+                                          DEFAULT_TEST_NETIF,
+                                          (uint8_t *)DEFAULT_TEST_L2_ADDR,
+                                          DEFAULT_TEST_L2_ADDR_LEN));
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dc_invalidate__nc_add(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST, next_hop = DEFAULT_TEST_NEXT_HOP;
+
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &next_hop,
+                                          TEST_STRING4, sizeof(TEST_STRING4),
+                                          0));
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dc_invalidate__nc_remove(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST, next_hop = DEFAULT_TEST_NEXT_HOP;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &next_hop,
+                                          TEST_STRING4, sizeof(TEST_STRING4),
+                                          0));
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_nc_remove(DEFAULT_TEST_NETIF, &next_hop);
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dc_invalidate__netif_add_addr(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST, src = DEFAULT_TEST_SRC;
+
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(DEFAULT_TEST_NETIF, &src, 64,
+                                                  GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST));
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dc_invalidate__netif_remove_addr(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_DST, src = DEFAULT_TEST_SRC;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_add_addr(DEFAULT_TEST_NETIF, &src, 64,
+                                                  GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST));
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_netif_remove_addr(DEFAULT_TEST_NETIF, &src);
+    TEST_ASSERT_NULL(gnrc_ipv6_dc_get(KERNEL_PID_UNDEF, &dst));
+}
+
+Test *tests_ipv6_dc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ipv6_dc_get__empty),
+        new_TestFixture(test_ipv6_dc_get__success),
+        new_TestFixture(test_ipv6_dc_get__different_if),
+        new_TestFixture(test_ipv6_dc_get__expired),
+        new_TestFixture(test_ipv6_dc_add__no_src),
+        new_TestFixture(test_ipv6_dc_add__update),
+        new_TestFixture(test_ipv6_dc_add__full_replace_oldest),
+        new_TestFixture(test_ipv6_dc_invalidate__success),
+        new_TestFixture(test_ipv6_dc_invalidate__during_lookup),
+        new_TestFixture(test_ipv6_dc_invalidate__nc_add),
+        new_TestFixture(test_ipv6_dc_invalidate__nc_remove),
+        new_TestFixture(test_ipv6_dc_invalidate__netif_add_addr),
+        new_TestFixture(test_ipv6_dc_invalidate__netif_remove_addr),
+    };
+
+    EMB_UNIT_TESTCALLER(ipv6_dc_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&ipv6_dc_tests;
+}
+
+void tests_ipv6_dc(void)
+{
+    TESTS_RUN(tests_ipv6_dc_tests());
+}
+/** @} */
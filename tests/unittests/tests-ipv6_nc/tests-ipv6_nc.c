@@ -12,6 +12,7 @@
  * @file
  */
 #include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "embUnit.h"
@@ -19,6 +20,7 @@
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
+#include "xtimer.h"
 
 #include "unittests-constants.h"
 #include "tests-ipv6_nc.h"
@@ -41,6 +43,11 @@
         } \
     }
 
+/* number of lookups in the large neighbor cache */
+#define LOOKUPS                 (10000U)
+/* flags of an entry that is managed by NDP */
+#define MANAGED_FLAGS           (GNRC_IPV6_NC_STATE_STALE << GNRC_IPV6_NC_STATE_POS)
+
 /* a third IPv6 addr for testing */
 #define THIRD_TEST_IPV6_ADDR    { { \
             0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, \
@@ -118,6 +125,58 @@ static void test_ipv6_nc_add__full(void)
                                       sizeof(TEST_STRING4), 0));
 }
 
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+static void test_ipv6_nc_add__full_replace_lru(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR, second = DEFAULT_TEST_IPV6_ADDR;
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4), MANAGED_FLAGS));
+        addr.u16[7].u16++;
+    }
+    second.u16[7].u16++;
+    /* the first entry is used again, so the second one is least recently used */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4), MANAGED_FLAGS));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
+}
+
+static void test_ipv6_nc_add__full_keep_routers_and_registered(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t router = DEFAULT_TEST_IPV6_ADDR, registered = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t third = DEFAULT_TEST_IPV6_ADDR;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4),
+                                          MANAGED_FLAGS | GNRC_IPV6_NC_IS_ROUTER));
+    addr.u16[7].u16++;
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4),
+                                          MANAGED_FLAGS | GNRC_IPV6_NC_TYPE_REGISTERED));
+    addr.u16[7].u16++;
+    for (int i = 2; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4), MANAGED_FLAGS));
+        addr.u16[7].u16++;
+    }
+    registered.u16[7].u16 += 1;
+    third.u16[7].u16 += 2;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4), MANAGED_FLAGS));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &router));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &registered));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &third));
+}
+#endif
+
 static void test_ipv6_nc_add__success(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
@@ -440,6 +499,37 @@ static void test_ipv6_nc_get_l2_addr__reachable(void)
     TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING4), l2_addr_len);
 }
 
+/* looks up every neighbor of a full neighbor cache in turn and prints the
+ * time it took */
+static void test_ipv6_nc_get__full_benchmark(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    uint32_t start, duration;
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        addr.u16[6] = byteorder_htons((uint16_t)(i * 7));
+        addr.u16[7] = byteorder_htons((uint16_t)i);
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4), MANAGED_FLAGS));
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        uint16_t idx = (uint16_t)(i % GNRC_IPV6_NC_SIZE);
+        gnrc_ipv6_nc_t *entry;
+
+        addr.u16[6] = byteorder_htons((uint16_t)(idx * 7));
+        addr.u16[7] = byteorder_htons(idx);
+        entry = gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT(ipv6_addr_equal(&entry->ipv6_addr, &addr));
+    }
+    duration = xtimer_now() - start;
+
+    printf("\n[ipv6_nc] %u lookups in a neighbor cache of %u entries took %lu us\n",
+           LOOKUPS, (unsigned)GNRC_IPV6_NC_SIZE, (unsigned long)duration);
+}
+
 Test *tests_ipv6_nc_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -449,6 +539,10 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_add__addr_unspecified),
         new_TestFixture(test_ipv6_nc_add__l2addr_too_long),
         new_TestFixture(test_ipv6_nc_add__full),
+#ifdef MODULE_GNRC_IPV6_NC_HASH
+        new_TestFixture(test_ipv6_nc_add__full_replace_lru),
+        new_TestFixture(test_ipv6_nc_add__full_keep_routers_and_registered),
+#endif
         new_TestFixture(test_ipv6_nc_add__success),
         new_TestFixture(test_ipv6_nc_add__address_update_despite_free_entry),
         new_TestFixture(test_ipv6_nc_remove__no_entry_pid),
@@ -475,6 +569,7 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_get_l2_addr__NULL_entry),
         new_TestFixture(test_ipv6_nc_get_l2_addr__unreachable),
         new_TestFixture(test_ipv6_nc_get_l2_addr__reachable),
+        new_TestFixture(test_ipv6_nc_get__full_benchmark),
     };
 
     EMB_UNIT_TESTCALLER(ipv6_nc_tests, set_up, tear_down, fixtures);
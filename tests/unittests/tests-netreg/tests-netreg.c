@@ -26,6 +26,10 @@ static gnrc_netreg_entry_t entries[] = {
     { NULL, TEST_UINT16, TEST_UINT8 + 1 }
 };
 
+#define MANY_ENTRIES_NUMOF  (64U)
+
+static gnrc_netreg_entry_t many_entries[MANY_ENTRIES_NUMOF];
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +143,69 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+static void _register_many(void)
+{
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i++) {
+        many_entries[i].next = NULL;
+        /* every demux context is used by two entries */
+        many_entries[i].demux_ctx = TEST_UINT16 + (i / 2);
+        many_entries[i].pid = TEST_UINT8;
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &many_entries[i]));
+    }
+}
+
+void test_netreg_lookup__many_entries(void)
+{
+    gnrc_netreg_entry_t *res;
+
+    _register_many();
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i += 2) {
+        TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16 + (i / 2))));
+        /* the entry registered last is found first */
+        TEST_ASSERT(&many_entries[i + 1] == res);
+        TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+        TEST_ASSERT(&many_entries[i] == res);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                        TEST_UINT16 + MANY_ENTRIES_NUMOF));
+}
+
+void test_netreg_lookup__same_ctx_other_type(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entries[0]));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT(&entries[0] == gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+    TEST_ASSERT(&entries[1] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+}
+
+void test_netreg_num__many_entries(void)
+{
+    _register_many();
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i += 2) {
+        TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST,
+                                                 TEST_UINT16 + (i / 2)));
+    }
+    /* remove first and last entry of every demux context in turn */
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many_entries[i + ((i / 2) & 1)]);
+    }
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i += 2) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + (i / 2));
+
+        TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST,
+                                                 TEST_UINT16 + (i / 2)));
+        TEST_ASSERT(&many_entries[i + !((i / 2) & 1)] == res);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -149,10 +216,13 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_unregister__success3),
         new_TestFixture(test_netreg_lookup__wrong_type_undef),
         new_TestFixture(test_netreg_lookup__wrong_type_numof),
+        new_TestFixture(test_netreg_lookup__many_entries),
+        new_TestFixture(test_netreg_lookup__same_ctx_other_type),
         new_TestFixture(test_netreg_num__empty),
         new_TestFixture(test_netreg_num__wrong_type_undef),
         new_TestFixture(test_netreg_num__wrong_type_numof),
         new_TestFixture(test_netreg_num__2_entries),
+        new_TestFixture(test_netreg_num__many_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
     };
@@ -219,6 +219,8 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
+/* gnrc_pktbuf_slab hands out fixed size chunks, so a freed chunk fits */
+#ifndef MODULE_GNRC_PKTBUF_SLAB
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -237,6 +239,7 @@ static void test_pktbuf_add__unaligned_in_aligned_hole(void)
     gnrc_pktbuf_release(pkt4);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
+#endif
 
 static void test_pktbuf_mark__pkt_NULL__size_0(void)
 {
@@ -738,7 +741,9 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_add__memfull),
         new_TestFixture(test_pktbuf_add__success),
         new_TestFixture(test_pktbuf_add__packed_struct),
+#ifndef MODULE_GNRC_PKTBUF_SLAB
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
+#endif
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_0),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_not_0),
         new_TestFixture(test_pktbuf_mark__pkt_NOT_NULL__size_0),
@@ -12,6 +12,7 @@
  * @file
  */
 #include <errno.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "thread.h"
@@ -22,6 +23,15 @@
 #include "unittests-constants.h"
 
 #include "net/sixlowpan.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ipv6/hdr.h"
+#include "net/udp.h"
+#include "xtimer.h"
+#endif
 
 #define NALP_0  (0x00) /* 00 00 00 00 */
 #define NALP_1  (0x01) /* 00 00 00 01 */
@@ -45,6 +55,29 @@
 #define FRAG1_DISP      (0xC5)  /* 11 00 01 01 */
 #define FRAGN_DISP      (0xE5)  /* 11 10 01 01 */
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+#define PAYLOAD_SIZE    (16U)
+#define SRC_PORT        (0xf0b1)
+#define DST_PORT        (0xf0b2)
+#define CHECKSUM        (0xabcd)
+#define CTX_ID          (1U)
+/* number of packets encoded at once in the benchmark */
+#define BENCH_PKTS      (16U)
+/* number of times BENCH_PKTS are encoded in the benchmark */
+#define BENCH_ROUNDS    (500U)
+
+/* fe80::1 and fe80::2 can be derived from the link layer addresses */
+#define LL_SRC      { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 } }
+#define LL_DST      { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02 } }
+/* 2001:db8::1 and 2001:db8::2 only with context 2001:db8::/64 */
+#define GLOBAL_SRC  { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 } }
+#define GLOBAL_DST  { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02 } }
+
+static uint8_t src_l2addr[] = { 0x02, 0, 0, 0, 0, 0, 0, 0x01 };
+static uint8_t dst_l2addr[] = { 0x02, 0, 0, 0, 0, 0, 0, 0x02 };
+static uint8_t other_l2addr[] = { 0x02, 0, 0, 0, 0, 0, 0, 0x03 };
+#endif
+
 
 /* Test with 6LoWPAN dispatch byte indicating a none-LoWPAN frame (NALP = Not a
  * LoWPAN frame)
@@ -147,6 +180,225 @@ static void test_sixlowpan_nalp_is_6lowpan_frame_12(void)
     TEST_ASSERT(!sixlowpan_nalp(FRAGN_DISP));
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+static gnrc_pktsnip_t *_build_udp(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                                  uint8_t hl, uint16_t checksum, uint8_t *l2dst)
+{
+    gnrc_pktsnip_t *netif, *ipv6, *udp, *payload;
+    ipv6_hdr_t *ipv6_hdr;
+    udp_hdr_t *udp_hdr;
+
+    netif = gnrc_netif_hdr_build(src_l2addr, sizeof(src_l2addr), l2dst,
+                                 sizeof(dst_l2addr));
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    udp = gnrc_pktbuf_add(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UNDEF);
+    ipv6 = gnrc_pktbuf_add(udp, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if ((netif == NULL) || (payload == NULL) || (udp == NULL) || (ipv6 == NULL)) {
+        /* the packet buffer is reset for every test */
+        return NULL;
+    }
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(SRC_PORT);
+    udp_hdr->dst_port = byteorder_htons(DST_PORT);
+    udp_hdr->length = byteorder_htons(sizeof(udp_hdr_t) + PAYLOAD_SIZE);
+    udp_hdr->checksum = byteorder_htons(checksum);
+    ipv6_hdr = ipv6->data;
+    memset(ipv6_hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(ipv6_hdr);
+    ipv6_hdr->len = byteorder_htons(sizeof(udp_hdr_t) + PAYLOAD_SIZE);
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = hl;
+    memcpy(&ipv6_hdr->src, src, sizeof(ipv6_addr_t));
+    memcpy(&ipv6_hdr->dst, dst, sizeof(ipv6_addr_t));
+    netif->next = ipv6;
+    return netif;
+}
+
+/* encodes pkt and checks its IPHC header against exp */
+static void _encode_and_check(gnrc_pktsnip_t *pkt, const uint8_t *exp, size_t exp_len)
+{
+    gnrc_pktsnip_t *dispatch;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(gnrc_sixlowpan_iphc_encode(pkt));
+    dispatch = pkt->next;
+    TEST_ASSERT_NOT_NULL(dispatch);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_SIXLOWPAN, dispatch->type);
+    TEST_ASSERT_EQUAL_INT(exp_len, dispatch->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp, dispatch->data, exp_len));
+}
+
+/* checks the UDP header compressed with NHC behind the IPHC header */
+static void _check_nhc_udp(gnrc_pktsnip_t *pkt, uint16_t checksum)
+{
+    gnrc_pktsnip_t *udp = pkt->next->next;
+    uint8_t *data = udp->data;
+
+    TEST_ASSERT_EQUAL_INT(3, udp->size);
+    /* both ports are compressed to 4 bits */
+    TEST_ASSERT_EQUAL_INT(((SRC_PORT & 0xf) << 4) | (DST_PORT & 0xf), data[0]);
+    TEST_ASSERT_EQUAL_INT(checksum >> 8, data[1]);
+    TEST_ASSERT_EQUAL_INT(checksum & 0xff, data[2]);
+}
+
+static void set_up_iphc(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_sixlowpan_ctx_reset();
+}
+
+static void test_sixlowpan_iphc_encode__link_local(void)
+{
+    ipv6_addr_t src = LL_SRC, dst = LL_DST;
+    /* TF elided, NH compressed, HL 64, addresses derived from link layer */
+    const uint8_t exp[] = { 0x7e, 0x33, 0xf3 };
+
+    /* second packet of the flow is encoded the same */
+    for (int i = 0; i < 2; i++) {
+        gnrc_pktsnip_t *pkt = _build_udp(&src, &dst, 64, CHECKSUM, dst_l2addr);
+
+        _encode_and_check(pkt, exp, sizeof(exp));
+        _check_nhc_udp(pkt, CHECKSUM);
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__checksum(void)
+{
+    ipv6_addr_t src = LL_SRC, dst = LL_DST;
+    const uint8_t exp[] = { 0x7e, 0x33, 0xf3 };
+
+    for (uint16_t checksum = CHECKSUM; checksum < (CHECKSUM + 3); checksum++) {
+        gnrc_pktsnip_t *pkt = _build_udp(&src, &dst, 64, checksum, dst_l2addr);
+
+        _encode_and_check(pkt, exp, sizeof(exp));
+        _check_nhc_udp(pkt, checksum);
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__hop_limit(void)
+{
+    ipv6_addr_t src = LL_SRC, dst = LL_DST;
+    /* hop limit inline */
+    uint8_t exp_inline[] = { 0x7c, 0x33, 0x00, 0xf3 };
+    const uint8_t exp_64[] = { 0x7e, 0x33, 0xf3 };
+    const uint8_t exp_255[] = { 0x7f, 0x33, 0xf3 };
+    const uint8_t hls[] = { 17, 18, 64, 19, 255, 17 };
+    gnrc_pktsnip_t *pkt;
+
+    for (unsigned i = 0; i < sizeof(hls); i++) {
+        pkt = _build_udp(&src, &dst, hls[i], CHECKSUM, dst_l2addr);
+        if (hls[i] == 64) {
+            _encode_and_check(pkt, exp_64, sizeof(exp_64));
+        }
+        else if (hls[i] == 255) {
+            _encode_and_check(pkt, exp_255, sizeof(exp_255));
+        }
+        else {
+            exp_inline[2] = hls[i];
+            _encode_and_check(pkt, exp_inline, sizeof(exp_inline));
+        }
+        _check_nhc_udp(pkt, CHECKSUM);
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__l2addr_changed(void)
+{
+    ipv6_addr_t src = LL_SRC, dst = LL_DST;
+    const uint8_t exp[] = { 0x7e, 0x33, 0xf3 };
+    /* destination IID can't be derived from the link layer address anymore */
+    const uint8_t exp_other[] = { 0x7e, 0x31, 0, 0, 0, 0, 0, 0, 0, 0x02, 0xf3 };
+    gnrc_pktsnip_t *pkt;
+
+    pkt = _build_udp(&src, &dst, 64, CHECKSUM, dst_l2addr);
+    _encode_and_check(pkt, exp, sizeof(exp));
+    gnrc_pktbuf_release(pkt);
+    pkt = _build_udp(&src, &dst, 64, CHECKSUM, other_l2addr);
+    _encode_and_check(pkt, exp_other, sizeof(exp_other));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__ctx_changed(void)
+{
+    ipv6_addr_t src = GLOBAL_SRC, dst = GLOBAL_DST;
+    /* both addresses inline */
+    uint8_t exp_full[2 + (2 * sizeof(ipv6_addr_t)) + 1] = { 0x7e, 0x00 };
+    /* CID extension, SAC and DAC, addresses derived from context and link layer */
+    const uint8_t exp_ctx[] = { 0x7e, 0xf7, (CTX_ID << 4) | CTX_ID, 0xf3 };
+    gnrc_pktsnip_t *pkt;
+
+    memcpy(&exp_full[2], &src, sizeof(ipv6_addr_t));
+    memcpy(&exp_full[2 + sizeof(ipv6_addr_t)], &dst, sizeof(ipv6_addr_t));
+    exp_full[sizeof(exp_full) - 1] = 0xf3;
+
+    pkt = _build_udp(&src, &dst, 64, CHECKSUM, dst_l2addr);
+    _encode_and_check(pkt, exp_full, sizeof(exp_full));
+    gnrc_pktbuf_release(pkt);
+
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(CTX_ID, &src, 64, 1, true));
+    pkt = _build_udp(&src, &dst, 64, CHECKSUM, dst_l2addr);
+    _encode_and_check(pkt, exp_ctx, sizeof(exp_ctx));
+    gnrc_pktbuf_release(pkt);
+
+    gnrc_sixlowpan_ctx_remove(CTX_ID);
+    pkt = _build_udp(&src, &dst, 64, CHECKSUM, dst_l2addr);
+    _encode_and_check(pkt, exp_full, sizeof(exp_full));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sixlowpan_iphc_encode__benchmark(void)
+{
+    ipv6_addr_t src = GLOBAL_SRC, dst = GLOBAL_DST;
+    gnrc_pktsnip_t *pkts[BENCH_PKTS];
+    uint32_t start, duration = 0;
+
+    /* addresses are compressed with a context as with 6LoWPAN-ND */
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(CTX_ID, &src, 64, 1, true));
+    for (unsigned round = 0; round < BENCH_ROUNDS; round++) {
+        for (unsigned i = 0; i < BENCH_PKTS; i++) {
+            pkts[i] = _build_udp(&src, &dst, 64, (uint16_t)i, dst_l2addr);
+            TEST_ASSERT_NOT_NULL(pkts[i]);
+        }
+        start = xtimer_now();
+        for (unsigned i = 0; i < BENCH_PKTS; i++) {
+            TEST_ASSERT(gnrc_sixlowpan_iphc_encode(pkts[i]));
+        }
+        duration += xtimer_now() - start;
+        for (unsigned i = 0; i < BENCH_PKTS; i++) {
+            _check_nhc_udp(pkts[i], (uint16_t)i);
+            gnrc_pktbuf_release(pkts[i]);
+        }
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+
+    printf("\n[sixlowpan_iphc] encoding %u packets of one flow took %lu us\n",
+           BENCH_PKTS * BENCH_ROUNDS, (unsigned long)duration);
+}
+
+Test *test_sixlowpan_iphc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sixlowpan_iphc_encode__link_local),
+        new_TestFixture(test_sixlowpan_iphc_encode__checksum),
+        new_TestFixture(test_sixlowpan_iphc_encode__hop_limit),
+        new_TestFixture(test_sixlowpan_iphc_encode__l2addr_changed),
+        new_TestFixture(test_sixlowpan_iphc_encode__ctx_changed),
+        new_TestFixture(test_sixlowpan_iphc_encode__benchmark),
+    };
+
+    EMB_UNIT_TESTCALLER(test_sixlowpan_iphc_tests_caller, set_up_iphc, NULL, fixtures);
+
+    return (Test *)&test_sixlowpan_iphc_tests_caller;
+}
+#endif
+
 Test *test_sixlowpan_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -180,5 +432,8 @@ Test *test_sixlowpan_tests(void)
 void tests_sixlowpan(void)
 {
     TESTS_RUN(test_sixlowpan_tests());
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    TESTS_RUN(test_sixlowpan_iphc_tests());
+#endif
 }
 /** @} */
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ *
+ * @author      agent <agent@local>
+ */
+#include <string.h>
+
+#include "embUnit.h"
+#include "msg.h"
+#include "random.h"
+#include "thread.h"
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+
+#include "rbuf.h"
+
+#include "unittests-constants.h"
+#include "tests-sixlowpan_frag.h"
+
+#define L2ADDR_LEN      (8U)
+#define QUEUE_SIZE      (16U)
+#define DATAGRAMS       (RBUF_SIZE / 2) /* leave room for entries started by
+                                         * late duplicates */
+#define MIN_SIZE        (64U)
+#define MAX_SIZE        (600U)
+#define MAX_FRAG_SIZE   (96U)
+#define FRAGS_MAX       (DATAGRAMS * (MAX_SIZE / 8) * 2)
+#define FUZZ_ROUNDS     (50U)
+#define LARGE_SIZE      (400U)
+#define SMALL_SIZE      (96U)
+
+typedef struct {
+    uint8_t dgram;
+    uint16_t offset;
+    uint16_t len;
+} test_frag_t;
+
+static msg_t _queue[QUEUE_SIZE];
+static gnrc_netreg_entry_t _entry;
+static uint8_t _dst_l2addr[L2ADDR_LEN] = { 0x02, 0, 0, 0, 0, 0, 0, 0xff };
+static uint8_t _dgrams[DATAGRAMS][MAX_SIZE];
+static size_t _sizes[DATAGRAMS];
+static test_frag_t _frags[FRAGS_MAX];
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    msg_init_queue(_queue, QUEUE_SIZE);
+    _entry.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    _entry.pid = thread_getpid();
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_entry);
+}
+
+static void tear_down(void)
+{
+    msg_t msg;
+
+    rbuf_reset();
+    while (msg_try_receive(&msg) == 1) {
+        gnrc_pktbuf_release((gnrc_pktsnip_t *)msg.content.ptr);
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &_entry);
+}
+
+static void _fill(uint8_t *dgram, size_t size)
+{
+    for (unsigned i = 0; i < size; i++) {
+        dgram[i] = (uint8_t)random_uint32();
+    }
+}
+
+static void _send_frag(uint8_t src, uint16_t tag, const uint8_t *dgram,
+                       size_t size, size_t offset, size_t len)
+{
+    uint8_t src_l2addr[L2ADDR_LEN] = { 0x02, 0, 0, 0, 0, 0, 0, src };
+    size_t hdr_len = (offset == 0) ? (sizeof(sixlowpan_frag_t) + 1)
+                                   : sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_frag_n_t *hdr;
+
+    netif = gnrc_netif_hdr_build(src_l2addr, L2ADDR_LEN, _dst_l2addr, L2ADDR_LEN);
+    TEST_ASSERT_NOT_NULL(netif);
+    frag = gnrc_pktbuf_add(netif, NULL, hdr_len + len, GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(frag);
+    hdr = frag->data;
+    hdr->disp_size = byteorder_htons((uint16_t)size);
+    hdr->tag = byteorder_htons(tag);
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        ((uint8_t *)frag->data)[sizeof(sixlowpan_frag_t)] = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = (uint8_t)(offset / 8);
+    }
+    memcpy(((uint8_t *)frag->data) + hdr_len, dgram + offset, len);
+    gnrc_sixlowpan_frag_handle_pkt(frag);
+}
+
+/* sends a whole datagram in fragments of frag_size bytes */
+static void _send_dgram(uint8_t src, uint16_t tag, const uint8_t *dgram,
+                        size_t size, size_t frag_size)
+{
+    for (size_t offset = 0; offset < size; offset += frag_size) {
+        size_t len = ((size - offset) < frag_size) ? (size - offset) : frag_size;
+        _send_frag(src, tag, dgram, size, offset, len);
+    }
+}
+
+/* gets the next reassembled datagram, NULL if there is none */
+static gnrc_pktsnip_t *_recv(void)
+{
+    msg_t msg;
+
+    if (msg_try_receive(&msg) != 1) {
+        return NULL;
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+    return (gnrc_pktsnip_t *)msg.content.ptr;
+}
+
+static bool _equals(gnrc_pktsnip_t *pkt, const uint8_t *dgram, size_t size)
+{
+    return (pkt->size == size) && (memcmp(pkt->data, dgram, size) == 0);
+}
+
+static void _expect_dgram(const uint8_t *dgram, size_t size)
+{
+    gnrc_pktsnip_t *pkt = _recv();
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(_equals(pkt, dgram, size));
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_rbuf_in_order(void)
+{
+    _fill(_dgrams[0], LARGE_SIZE);
+    _send_dgram(1, TEST_UINT16, _dgrams[0], LARGE_SIZE, 48);
+    _expect_dgram(_dgrams[0], LARGE_SIZE);
+    TEST_ASSERT_NULL(_recv());
+}
+
+static void test_rbuf_interleaved(void)
+{
+    _fill(_dgrams[0], LARGE_SIZE);
+    _fill(_dgrams[1], LARGE_SIZE);
+    /* same source and size, only the tag differs */
+    for (size_t offset = 0; offset < LARGE_SIZE; offset += 80) {
+        _send_frag(1, 1, _dgrams[0], LARGE_SIZE, offset, 80);
+        _send_frag(1, 2, _dgrams[1], LARGE_SIZE, offset, 80);
+    }
+    _expect_dgram(_dgrams[0], LARGE_SIZE);
+    _expect_dgram(_dgrams[1], LARGE_SIZE);
+    TEST_ASSERT_NULL(_recv());
+}
+
+static void test_rbuf_duplicate(void)
+{
+    _fill(_dgrams[0], SMALL_SIZE);
+    /* the size of a duplicate must not count towards the datagram */
+    _send_frag(1, 1, _dgrams[0], SMALL_SIZE, 0, SMALL_SIZE / 2);
+    _send_frag(1, 1, _dgrams[0], SMALL_SIZE, 0, SMALL_SIZE / 2);
+    TEST_ASSERT_NULL(_recv());
+    _send_frag(1, 1, _dgrams[0], SMALL_SIZE, SMALL_SIZE / 2, SMALL_SIZE / 2);
+    _expect_dgram(_dgrams[0], SMALL_SIZE);
+    TEST_ASSERT_NULL(_recv());
+}
+
+static void test_rbuf_overlap(void)
+{
+    _fill(_dgrams[0], SMALL_SIZE);
+    _fill(_dgrams[1], SMALL_SIZE);
+    _send_frag(1, 1, _dgrams[0], SMALL_SIZE, 0, 48);
+    _send_frag(1, 1, _dgrams[0], SMALL_SIZE, 48, 16);
+    /* differs in size from the first fragment: starts over with this one */
+    _send_frag(1, 1, _dgrams[1], SMALL_SIZE, 0, 56);
+    _send_frag(1, 1, _dgrams[1], SMALL_SIZE, 56, 40);
+    _expect_dgram(_dgrams[1], SMALL_SIZE);
+    TEST_ASSERT_NULL(_recv());
+}
+
+static void test_rbuf_evict__large_flood(void)
+{
+    _fill(_dgrams[0], LARGE_SIZE);
+    _fill(_dgrams[1], SMALL_SIZE);
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        _send_frag(1, i, _dgrams[0], LARGE_SIZE, 0, 64);
+    }
+    /* a small datagram pushes out a large one */
+    _send_dgram(2, 0, _dgrams[1], SMALL_SIZE, 64);
+    _expect_dgram(_dgrams[1], SMALL_SIZE);
+    TEST_ASSERT_NULL(_recv());
+}
+
+static void test_rbuf_evict__no_smaller(void)
+{
+    _fill(_dgrams[0], LARGE_SIZE);
+    _fill(_dgrams[1], SMALL_SIZE);
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        _send_frag(1, i, _dgrams[1], SMALL_SIZE, 0, 64);
+    }
+    /* a large datagram does not push out smaller ones */
+    _send_dgram(2, 0, _dgrams[0], LARGE_SIZE, 64);
+    TEST_ASSERT_NULL(_recv());
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        _send_frag(1, i, _dgrams[1], SMALL_SIZE, 64, SMALL_SIZE - 64);
+        _expect_dgram(_dgrams[1], SMALL_SIZE);
+    }
+    TEST_ASSERT_NULL(_recv());
+}
+
+static void test_rbuf_fuzz(void)
+{
+    random_init(TEST_UINT32);
+
+    for (unsigned round = 0; round < FUZZ_ROUNDS; round++) {
+        unsigned numof = 0, delivered = 0;
+        gnrc_pktsnip_t *pkt;
+
+        /* cut datagrams into fragments of random size */
+        for (unsigned i = 0; i < DATAGRAMS; i++) {
+            _sizes[i] = random_uint32_range(MIN_SIZE, MAX_SIZE + 1);
+            _fill(_dgrams[i], _sizes[i]);
+            for (size_t offset = 0; offset < _sizes[i];) {
+                size_t len = random_uint32_range(1, (MAX_FRAG_SIZE / 8) + 1) * 8;
+
+                if (len > (_sizes[i] - offset)) {
+                    len = _sizes[i] - offset;
+                }
+                _frags[numof].dgram = i;
+                _frags[numof].offset = offset;
+                _frags[numof].len = len;
+                numof++;
+                offset += len;
+            }
+        }
+        /* duplicate every fourth fragment on average */
+        for (unsigned i = 0, n = numof; (i < n) && (numof < FRAGS_MAX); i++) {
+            if (random_uint32_range(0, 4) == 0) {
+                _frags[numof++] = _frags[i];
+            }
+        }
+        /* shuffle */
+        for (unsigned i = numof - 1; i > 0; i--) {
+            unsigned j = random_uint32_range(0, i + 1);
+            test_frag_t tmp = _frags[i];
+            _frags[i] = _frags[j];
+            _frags[j] = tmp;
+        }
+
+        for (unsigned i = 0; i < numof; i++) {
+            test_frag_t *frag = &_frags[i];
+
+            _send_frag(frag->dgram + 1, round, _dgrams[frag->dgram],
+                       _sizes[frag->dgram], frag->offset, frag->len);
+        }
+
+        /* late duplicates may complete a datagram twice, but every datagram
+         * must be complete and intact */
+        while ((pkt = _recv()) != NULL) {
+            bool found = false;
+
+            for (unsigned i = 0; i < DATAGRAMS; i++) {
+                if (_equals(pkt, _dgrams[i], _sizes[i])) {
+                    delivered |= (1 << i);
+                    found = true;
+                }
+            }
+            gnrc_pktbuf_release(pkt);
+            TEST_ASSERT(found);
+        }
+        TEST_ASSERT_EQUAL_INT((1 << DATAGRAMS) - 1, delivered);
+
+        /* drop entries started by late duplicates. Entries leaking packet
+         * buffer space would let later rounds run out of it */
+        rbuf_reset();
+        TEST_ASSERT(gnrc_pktbuf_is_sane());
+    }
+}
+
+Test *tests_sixlowpan_frag_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rbuf_in_order),
+        new_TestFixture(test_rbuf_interleaved),
+        new_TestFixture(test_rbuf_duplicate),
+        new_TestFixture(test_rbuf_overlap),
+        new_TestFixture(test_rbuf_evict__large_flood),
+        new_TestFixture(test_rbuf_evict__no_smaller),
+        new_TestFixture(test_rbuf_fuzz),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_frag_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&sixlowpan_frag_tests;
+}
+
+void tests_sixlowpan_frag(void)
+{
+    TESTS_RUN(tests_sixlowpan_frag_tests());
+}
+/** @} */
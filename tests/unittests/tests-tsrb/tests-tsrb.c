@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "tsrb.h"
+
+#include "tests-tsrb.h"
+
+#define BUF_SIZE    (8U)
+
+static char buf[BUF_SIZE];
+static tsrb_t rb;
+
+static void set_up(void)
+{
+    memset(buf, 0, sizeof(buf));
+    tsrb_init(&rb, buf, sizeof(buf));
+}
+
+static void test_tsrb_add_get(void)
+{
+    char out[BUF_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(5, tsrb_add(&rb, "abcde", 5));
+    TEST_ASSERT_EQUAL_INT(3, tsrb_get(&rb, out, 3));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "abc", 3));
+    /* wraps around the end of the buffer, only 6 bytes fit */
+    TEST_ASSERT_EQUAL_INT(6, tsrb_add(&rb, "fghijkl", 7));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&rb));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_add_one(&rb, 'x'));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, tsrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "defghijk", BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_get_one(&rb));
+}
+
+static void test_tsrb_peek_span(void)
+{
+    tsrb_span_t span[2];
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_peek_span(&rb, span));
+    TEST_ASSERT_EQUAL_INT(0, span[0].len);
+    TEST_ASSERT_EQUAL_INT(0, span[1].len);
+
+    tsrb_add(&rb, "abcdef", 6);
+    TEST_ASSERT_EQUAL_INT(4, tsrb_drop(&rb, 4));
+    tsrb_add(&rb, "ghij", 4);
+
+    TEST_ASSERT_EQUAL_INT(6, tsrb_peek_span(&rb, span));
+    TEST_ASSERT_EQUAL_INT(4, span[0].len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span[0].buf, "efgh", 4));
+    TEST_ASSERT_EQUAL_INT(2, span[1].len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span[1].buf, "ij", 2));
+
+    /* peeking does not remove anything */
+    TEST_ASSERT_EQUAL_INT(6, tsrb_avail(&rb));
+    TEST_ASSERT_EQUAL_INT(5, tsrb_drop(&rb, 5));
+    TEST_ASSERT_EQUAL_INT('j', tsrb_get_one(&rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_drop(&rb, 1));
+}
+
+static void test_tsrb_write_span(void)
+{
+    tsrb_span_t span[2];
+    char out[BUF_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, tsrb_write_span(&rb, span));
+    TEST_ASSERT(span[0].buf == buf);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, span[0].len);
+    TEST_ASSERT_EQUAL_INT(0, span[1].len);
+
+    tsrb_add(&rb, "abcde", 5);
+    tsrb_drop(&rb, 3);
+
+    TEST_ASSERT_EQUAL_INT(6, tsrb_write_span(&rb, span));
+    TEST_ASSERT(span[0].buf == &buf[5]);
+    TEST_ASSERT_EQUAL_INT(3, span[0].len);
+    TEST_ASSERT(span[1].buf == buf);
+    TEST_ASSERT_EQUAL_INT(3, span[1].len);
+
+    /* nothing is visible before committing */
+    memcpy(span[0].buf, "fgh", 3);
+    memcpy(span[1].buf, "ij", 2);
+    TEST_ASSERT_EQUAL_INT(2, tsrb_avail(&rb));
+    tsrb_commit(&rb, 5);
+    TEST_ASSERT_EQUAL_INT(7, tsrb_avail(&rb));
+    TEST_ASSERT_EQUAL_INT(7, tsrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "defghij", 7));
+}
+
+static void test_tsrb_counter_overflow(void)
+{
+    tsrb_span_t span[2];
+    char out[4];
+
+    /* start right before the free running counters overflow */
+    rb.reads = rb.writes = (unsigned)-2;
+
+    TEST_ASSERT_EQUAL_INT(4, tsrb_add(&rb, "abcd", 4));
+    TEST_ASSERT_EQUAL_INT(4, tsrb_avail(&rb));
+    TEST_ASSERT_EQUAL_INT(4, tsrb_peek_span(&rb, span));
+    TEST_ASSERT_EQUAL_INT(2, span[0].len);
+    TEST_ASSERT_EQUAL_INT(2, span[1].len);
+    TEST_ASSERT_EQUAL_INT(4, tsrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "abcd", 4));
+}
+
+Test *tests_tsrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tsrb_add_get),
+        new_TestFixture(test_tsrb_peek_span),
+        new_TestFixture(test_tsrb_write_span),
+        new_TestFixture(test_tsrb_counter_overflow),
+    };
+
+    EMB_UNIT_TESTCALLER(tsrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tsrb_tests;
+}
+
+void tests_tsrb(void)
+{
+    TESTS_RUN(tests_tsrb_tests());
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Fills the universal address container table with thousands of
+ *              distinct addresses and measures add, find and replace times.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "byteorder.h"
+#include "universal_address.h"
+#include "xtimer.h"
+
+#define ADDR_NUMOF          (UNIVERSAL_ADDRESS_MAX_ENTRIES)
+
+static universal_address_container_t *containers[ADDR_NUMOF];
+
+static void _make_addr(uint8_t *addr, uint32_t i)
+{
+    /* 2001:db8::<i> */
+    memset(addr, 0, UNIVERSAL_ADDRESS_SIZE);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    network_uint32_t tmp = byteorder_htonl(i);
+    memcpy(&addr[UNIVERSAL_ADDRESS_SIZE - sizeof(tmp)], &tmp, sizeof(tmp));
+}
+
+static int _add_all(const char *name, uint32_t first, uint32_t last,
+                     uint8_t use_count)
+{
+    uint8_t addr[UNIVERSAL_ADDRESS_SIZE];
+    uint32_t start = xtimer_now();
+
+    for (uint32_t i = first; i < last; i++) {
+        _make_addr(addr, i);
+        universal_address_container_t *entry =
+            universal_address_add(addr, sizeof(addr));
+
+        if (entry == NULL) {
+            printf("error: adding address %" PRIu32 " failed\n", i);
+            return -1;
+        }
+        if ((use_count > 1) && (entry != containers[i % ADDR_NUMOF])) {
+            printf("error: address %" PRIu32 " in wrong container\n", i);
+            return -1;
+        }
+        if (entry->use_count != use_count) {
+            printf("error: address %" PRIu32 " has use count %u\n", i,
+                   (unsigned)entry->use_count);
+            return -1;
+        }
+        containers[i % ADDR_NUMOF] = entry;
+    }
+
+    printf("+ %s: %" PRIu32 " addresses in %" PRIu32 " us\n", name,
+           last - first, xtimer_now() - start);
+    return 0;
+}
+
+int main(void)
+{
+    uint8_t addr[UNIVERSAL_ADDRESS_SIZE];
+
+    puts("universal address container benchmark");
+    universal_address_init();
+
+    /* fill the table with distinct addresses */
+    if (_add_all("add", 0, ADDR_NUMOF, 1) < 0) {
+        return 1;
+    }
+    /* adding them again finds the existing containers */
+    if (_add_all("find", 0, ADDR_NUMOF, 2) < 0) {
+        return 1;
+    }
+    if (universal_address_get_num_used_entries() != ADDR_NUMOF) {
+        puts("error: unexpected number of used entries");
+        return 1;
+    }
+    _make_addr(addr, ADDR_NUMOF);
+    if (universal_address_add(addr, sizeof(addr)) != NULL) {
+        puts("error: address added to full table");
+        return 1;
+    }
+
+    /* release the first half and reuse the containers for new addresses */
+    for (unsigned i = 0; i < (ADDR_NUMOF / 2); i++) {
+        universal_address_rem(containers[i]);
+        universal_address_rem(containers[i]);
+    }
+    if (_add_all("replace", ADDR_NUMOF, ADDR_NUMOF + (ADDR_NUMOF / 2), 1) < 0) {
+        return 1;
+    }
+
+    /* the second half must be untouched */
+    for (uint32_t i = (ADDR_NUMOF / 2); i < ADDR_NUMOF; i++) {
+        size_t addr_size = sizeof(addr);
+        uint8_t exp[UNIVERSAL_ADDRESS_SIZE];
+
+        _make_addr(exp, i);
+        if ((containers[i]->use_count != 2) ||
+            (universal_address_get_address(containers[i], addr,
+                                           &addr_size) == NULL) ||
+            (memcmp(addr, exp, sizeof(exp)) != 0)) {
+            printf("error: address %" PRIu32 " got lost\n", i);
+            return 1;
+        }
+    }
+
+    puts("Test successful.");
+    return 0;
+}
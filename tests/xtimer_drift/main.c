@@ -52,10 +52,14 @@ struct timer_msg {
     msg_t msg;
 };
 
-struct timer_msg msg_a = { .interval = (TEST_INTERVAL / 2) };
-struct timer_msg msg_b = { .interval = (TEST_INTERVAL / 3) };
-struct timer_msg msg_c = { .interval = (TEST_INTERVAL * 5) };
-struct timer_msg msg_d = { .interval = (TEST_INTERVAL * 2) };
+struct timer_msg msg_a = { .timer = { .target = 0, .long_target = 0 },
+                           .interval = (TEST_INTERVAL / 2) };
+struct timer_msg msg_b = { .timer = { .target = 0, .long_target = 0 },
+                           .interval = (TEST_INTERVAL / 3) };
+struct timer_msg msg_c = { .timer = { .target = 0, .long_target = 0 },
+                           .interval = (TEST_INTERVAL * 5) };
+struct timer_msg msg_d = { .timer = { .target = 0, .long_target = 0 },
+                           .interval = (TEST_INTERVAL * 2) };
 
 /* This thread is only here to give the kernel some extra load */
 void *slacker_thread(void *arg)
@@ -90,6 +94,9 @@ void *worker_thread(void *arg)
     uint32_t loop_counter = 0;
     uint32_t start = 0;
     uint32_t last = 0;
+    uint32_t prev = 0;
+    int32_t period_min = INT32_MAX;
+    int32_t period_max = INT32_MIN;
 
     printf("Starting thread %" PRIkernel_pid "\n", thread_getpid());
 
@@ -100,10 +107,21 @@ void *worker_thread(void *arg)
         if (start == 0) {
             start = now;
             last = start;
+            prev = start;
             ++loop_counter;
             continue;
         }
 
+        /* deviation of every single period from the interval */
+        int32_t period = now - prev - TEST_INTERVAL;
+        if (period < period_min) {
+            period_min = period;
+        }
+        if (period > period_max) {
+            period_max = period;
+        }
+        prev = now;
+
         uint32_t us, sec;
         uint32_t min, hr;
         us = now % SEC_IN_USEC;
@@ -117,8 +135,12 @@ void *worker_thread(void *arg)
             int32_t jitter = now - expected;
             printf("now=%" PRIu32 ".%06" PRIu32 " (%" PRIu32 " hours %" PRIu32 " min), ",
                 sec, us, hr, min);
-            printf("drift=%" PRId32 " us, jitter=%" PRId32 " us\n", drift, jitter);
+            printf("drift=%" PRId32 " us, jitter=%" PRId32 " us, ", drift, jitter);
+            printf("period jitter=%" PRId32 "..%" PRId32 " us\n", period_min,
+                   period_max);
             last = now;
+            period_min = INT32_MAX;
+            period_max = INT32_MIN;
         }
         ++loop_counter;
     }
@@ -140,6 +162,8 @@ int main(void)
     puts("The first output variable, 'drift', represents the total offset since "
          "start between xtimer_now and the expected time.");
     puts("The second output variable, 'jitter', represents the difference in drift from the last printout.");
+    puts("The third output variable, 'period jitter', is the range of deviations "
+         "of the single periods since the last printout from the interval.");
     puts("Two other threads are also running only to cause extra interrupts and context switches.");
     puts(" <====== PC clock if running in pyterm.");
     puts("");
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sets, removes and fires many concurrent timers and measures
+ *              how long setting and removing them takes
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "random.h"
+#include "xtimer.h"
+
+#ifndef NUMOF
+#define NUMOF         (100U)
+#endif
+
+#define SEED                (0x2a2a2a2a)
+#define OFFSET_MIN          (100U * MS_IN_USEC)
+#define OFFSET_RANGE        (SEC_IN_USEC)
+
+static xtimer_t timers[NUMOF];
+static uint32_t targets[NUMOF];
+
+static volatile unsigned fired;
+static volatile unsigned early;
+static volatile unsigned unordered;
+static volatile uint32_t last_target;
+static volatile uint32_t max_late;
+
+static void _cb(void *arg)
+{
+    uint32_t now = xtimer_now();
+    uint32_t target = targets[(uintptr_t)arg];
+
+    if ((int32_t)(now - target) < 0) {
+        early++;
+    }
+    else if ((now - target) > max_late) {
+        max_late = now - target;
+    }
+    /* targets are taken a little before setting the timer */
+    if (fired && ((int32_t)(target + XTIMER_BACKOFF - last_target) < 0)) {
+        unordered++;
+    }
+    last_target = target;
+    fired++;
+}
+
+static void _set(unsigned i)
+{
+    uint32_t offset = OFFSET_MIN + (random_uint32() % OFFSET_RANGE);
+
+    targets[i] = xtimer_now() + offset;
+    xtimer_set(&timers[i], offset);
+}
+
+int main(void)
+{
+    uint32_t start, time;
+
+    puts("xtimer many timers benchmark");
+    random_init(SEED);
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        timers[i].callback = _cb;
+        timers[i].arg = (void *)(uintptr_t)i;
+    }
+
+    /* offsets are at least OFFSET_MIN, so no timer fires while measuring */
+    start = xtimer_now();
+    for (unsigned i = 0; i < NUMOF; i++) {
+        _set(i);
+    }
+    time = xtimer_now() - start;
+    printf("+ set: %u timers in %" PRIu32 " us\n", NUMOF, time);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < NUMOF; i += 2) {
+        xtimer_remove(&timers[i]);
+    }
+    time = xtimer_now() - start;
+    printf("+ remove: %u timers in %" PRIu32 " us\n", NUMOF / 2, time);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < NUMOF; i += 2) {
+        _set(i);
+    }
+    time = xtimer_now() - start;
+    printf("+ reset: %u timers in %" PRIu32 " us\n", NUMOF / 2, time);
+
+    xtimer_usleep(OFFSET_MIN + OFFSET_RANGE + time);
+    while (fired < NUMOF) {
+        xtimer_usleep(OFFSET_MIN);
+        if ((xtimer_now() - start) > (2 * (OFFSET_MIN + OFFSET_RANGE))) {
+            printf("error: only %u timers fired\n", fired);
+            return 1;
+        }
+    }
+    printf("+ fired: %u timers, max. late %" PRIu32 " us\n", fired, max_late);
+
+    if (early || unordered) {
+        printf("error: %u timers fired early, %u out of order\n", early,
+               unordered);
+        return 1;
+    }
+
+    puts("Test successful.");
+    return 0;
+}
@@ -38,8 +38,10 @@ struct timer_msg {
     msg_t msg;
 };
 
-struct timer_msg msg_a = { .interval = 2*(1000000), .text = "Hello World", };
-struct timer_msg msg_b = { .interval = 5*(1000000), .text = "This is a Test" };
+struct timer_msg msg_a = { .timer = { .target = 0, .long_target = 0 },
+                           .interval = 2*(1000000), .text = "Hello World", };
+struct timer_msg msg_b = { .timer = { .target = 0, .long_target = 0 },
+                           .interval = 5*(1000000), .text = "This is a Test" };
 
 void *timer_thread(void *arg)
 {